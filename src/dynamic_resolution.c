@@ -0,0 +1,113 @@
+#include "dynamic_resolution.h"
+#include "memory_tracker.h"
+#define GL_GLEXT_PROTOTYPES
+#include <GL/gl.h>
+#include <GL/glext.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+void DynamicResolution_Unload(DynamicResolution* drs) {
+    if (drs->target.id != 0) {
+        MemoryTracker_Account(MEMORY_RENDER_CACHES, -MEMORY_RENDER_TEXTURE_BYTES(drs->target.texture.width, drs->target.texture.height));
+        UnloadRenderTexture(drs->target);
+    }
+    if (drs->gpuQueries[0] != 0) glDeleteQueries(DRS_GPU_QUERIES, drs->gpuQueries);
+    memset(drs, 0, sizeof(*drs));
+}
+
+// GL_TIME_ELAPSED queries are core in desktop GL 3.3 and otherwise need
+// ARB_timer_query; GLES version strings do not parse and are left out
+static bool TimerQueriesSupported(void) {
+    const char* version = (const char*)glGetString(GL_VERSION);
+    int major = 0, minor = 0;
+    if (!version || sscanf(version, "%d.%d", &major, &minor) != 2) return false;
+    if (major > 3 || (major == 3 && minor >= 3)) return true;
+    const char* extensions = (const char*)glGetString(GL_EXTENSIONS);
+    return extensions && strstr(extensions, "GL_ARB_timer_query") != NULL;
+}
+
+float DynamicResolution_Begin(DynamicResolution* drs) {
+    int width = GetScreenWidth();
+    int height = GetScreenHeight();
+    if (drs->target.id == 0 || drs->target.texture.width != width || drs->target.texture.height != height) {
+        if (drs->target.id != 0) {
+            MemoryTracker_Account(MEMORY_RENDER_CACHES, -MEMORY_RENDER_TEXTURE_BYTES(drs->target.texture.width, drs->target.texture.height));
+            UnloadRenderTexture(drs->target);
+        }
+        drs->target = LoadRenderTexture(width, height);
+        MemoryTracker_Account(MEMORY_RENDER_CACHES, MEMORY_RENDER_TEXTURE_BYTES(drs->target.texture.width, drs->target.texture.height));
+        SetTextureFilter(drs->target.texture, TEXTURE_FILTER_BILINEAR);
+    }
+    if (!drs->gpuTimerChecked) {
+        drs->gpuTimerChecked = true;
+        if (TimerQueriesSupported()) {
+            glGenQueries(DRS_GPU_QUERIES, drs->gpuQueries);
+        } else {
+            TraceLog(LOG_INFO, "DRS: no GPU timer queries, scaling on CPU submit time only");
+        }
+    }
+    if (drs->scale == 0.0f) {
+        drs->scale = 1.0f;
+        drs->smoothedMs = 0.0f;
+        drs->framesSinceChange = 0;
+    }
+    drs->sceneStart = GetTime();
+    BeginTextureMode(drs->target); // flushes what was drawn before the scene
+    // With every query still in flight this scene goes untimed on the GPU
+    drs->gpuQueryActive = drs->gpuQueries[0] != 0 && drs->gpuQueriesPending < DRS_GPU_QUERIES;
+    if (drs->gpuQueryActive) glBeginQuery(GL_TIME_ELAPSED, drs->gpuQueries[drs->gpuQueryNext]);
+    return drs->scale;
+}
+
+// Steps the scale against the smoothed scene time
+static void UpdateScale(DynamicResolution* drs, float sceneMs) {
+    drs->smoothedMs = drs->smoothedMs == 0.0f ? sceneMs : drs->smoothedMs * 0.9f + sceneMs * 0.1f;
+    if (++drs->framesSinceChange < DRS_SETTLE_FRAMES) return;
+    float scale = drs->scale;
+    if (drs->smoothedMs > DRS_TARGET_FRAME_MS) {
+        scale = fmaxf(DRS_MIN_SCALE, scale - DRS_SCALE_STEP);
+    } else if (drs->smoothedMs < DRS_TARGET_FRAME_MS * (1.0f - DRS_HYSTERESIS)) {
+        scale = fminf(1.0f, scale + DRS_SCALE_STEP);
+    }
+    if (scale != drs->scale) {
+        drs->scale = scale;
+        drs->framesSinceChange = 0;
+    }
+}
+
+// Reads back every finished query, oldest first, without waiting
+static void ReadGpuQueries(DynamicResolution* drs) {
+    while (drs->gpuQueriesPending > 0) {
+        unsigned int query = drs->gpuQueries[(drs->gpuQueryNext - drs->gpuQueriesPending + DRS_GPU_QUERIES) % DRS_GPU_QUERIES];
+        GLint available = 0;
+        glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) break;
+        GLuint64 nanoseconds = 0;
+        glGetQueryObjectui64v(query, GL_QUERY_RESULT, &nanoseconds);
+        drs->gpuMs = (float)(nanoseconds / 1e6);
+        drs->gpuQueriesPending--;
+    }
+}
+
+void DynamicResolution_End(DynamicResolution* drs) {
+    float width = (float)drs->target.texture.width;
+    float height = (float)drs->target.texture.height;
+    float sceneWidth = floorf(width * drs->scale);
+    float sceneHeight = floorf(height * drs->scale);
+    EndTextureMode(); // flushes the scene's draw batch
+    float cpuMs = (float)((GetTime() - drs->sceneStart) * 1000.0);
+    if (drs->gpuQueryActive) {
+        glEndQuery(GL_TIME_ELAPSED);
+        drs->gpuQueryNext = (drs->gpuQueryNext + 1) % DRS_GPU_QUERIES;
+        drs->gpuQueriesPending++;
+    }
+    ReadGpuQueries(drs);
+    UpdateScale(drs, fmaxf(cpuMs, drs->gpuMs));
+
+    // Render textures are stored bottom-up, so the scene's top-left part is
+    // the top rows of the texture
+    Rectangle source = { 0, height - sceneHeight, sceneWidth, -sceneHeight };
+    Rectangle dest = { 0, 0, width, height };
+    DrawTexturePro(drs->target.texture, source, dest, (Vector2){0, 0}, 0.0f, WHITE);
+}
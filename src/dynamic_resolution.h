@@ -0,0 +1,50 @@
+#ifndef DYNAMIC_RESOLUTION_H
+#define DYNAMIC_RESOLUTION_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+// Renders the scene into the top-left part of a window-sized render texture
+// and stretches that part over the window. The part shrinks in
+// DRS_SCALE_STEP steps down to DRS_MIN_SCALE while the measured scene time
+// stays over DRS_TARGET_FRAME_MS, and grows back once it falls below
+// (1 - DRS_HYSTERESIS) of the target; at least DRS_SETTLE_FRAMES pass
+// between changes. The scene time is the larger of the CPU time spent
+// submitting the scene and its GPU time, read from a GL_TIME_ELAPSED query
+// up to DRS_GPU_QUERIES frames later so reading it never stalls. The GPU
+// time needs desktop GL 3.3 or ARB_timer_query, called on libGL directly;
+// without them only the CPU submit time is used.
+
+#ifndef DRS_TARGET_FRAME_MS
+#define DRS_TARGET_FRAME_MS 16.6f
+#endif
+#define DRS_MIN_SCALE 0.5f
+#define DRS_SCALE_STEP 0.05f
+#define DRS_HYSTERESIS 0.25f
+#define DRS_SETTLE_FRAMES 30
+#define DRS_GPU_QUERIES 4
+
+typedef struct {
+    RenderTexture2D target;
+    float scale;
+    float smoothedMs;
+    int framesSinceChange;
+    double sceneStart;
+    bool gpuTimerChecked;
+    unsigned int gpuQueries[DRS_GPU_QUERIES]; // ring of GL query objects, 0 if unsupported
+    int gpuQueryNext;     // next query to issue
+    int gpuQueriesPending; // issued but not read back, oldest first
+    bool gpuQueryActive;  // a query brackets the current scene
+    float gpuMs;          // latest GPU scene time read back
+} DynamicResolution;
+
+void DynamicResolution_Unload(DynamicResolution* drs);
+
+// Starts drawing the scene offscreen and returns the scale to apply to the
+// camera's offset and zoom and to the viewport size
+float DynamicResolution_Begin(DynamicResolution* drs);
+// Ends the scene, feeds its time to the controller and draws it over the
+// window; call outside BeginMode2D
+void DynamicResolution_End(DynamicResolution* drs);
+
+#endif
@@ -0,0 +1,44 @@
+#include "engine_counters.h"
+#include "telemetry.h"
+#include <string.h>
+
+unsigned int engineCounters[ENGINE_COUNTER_COUNT];
+static unsigned int engineCountersLastFrame[ENGINE_COUNTER_COUNT];
+#ifndef NO_ENGINE_COUNTERS
+static int engineCounterChannels[ENGINE_COUNTER_COUNT];
+#endif
+
+static const char* engineCounterNames[ENGINE_COUNTER_COUNT] = {
+    "Broadphase Segments",
+    "Collision Tests",
+    "Intersects Calls",
+    "DrawLineEx Calls",
+    "DrawCircleV Calls",
+    "Batch Vertices"
+};
+
+void EngineCounters_Init(void) {
+#ifndef NO_ENGINE_COUNTERS
+    for (int i = 0; i < ENGINE_COUNTER_COUNT; i++) {
+        engineCounterChannels[i] = Telemetry_Register(engineCounterNames[i], 0);
+    }
+#endif
+}
+
+void EngineCounters_FrameEnd(void) {
+#ifndef NO_ENGINE_COUNTERS
+    memcpy(engineCountersLastFrame, engineCounters, sizeof(engineCounters));
+    memset(engineCounters, 0, sizeof(engineCounters));
+    for (int i = 0; i < ENGINE_COUNTER_COUNT; i++) {
+        Telemetry_Push(engineCounterChannels[i], (float)engineCountersLastFrame[i]);
+    }
+#endif
+}
+
+const char* EngineCounters_Name(EngineCounter counter) {
+    return engineCounterNames[counter];
+}
+
+unsigned int EngineCounters_LastFrame(EngineCounter counter) {
+    return engineCountersLastFrame[counter];
+}
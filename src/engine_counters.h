@@ -0,0 +1,35 @@
+#ifndef ENGINE_COUNTERS_H
+#define ENGINE_COUNTERS_H
+
+// Per-frame work counters. ENGINE_COUNT adds to the current frame's tally;
+// EngineCounters_FrameEnd keeps the finished frame for display, pushes it to
+// one telemetry channel per counter and starts the next frame at zero.
+// Main thread only. Define NO_ENGINE_COUNTERS to compile the counting out.
+
+typedef enum {
+    COUNTER_BROADPHASE_SEGMENTS, // segments returned by the spatial queries
+    COUNTER_COLLISION_TESTS,     // CollisionWithLine calls
+    COUNTER_INTERSECTS,          // intersects calls
+    COUNTER_DRAW_LINES,          // DrawLineEx calls
+    COUNTER_DRAW_CIRCLES,        // DrawCircleV calls
+    COUNTER_BATCH_VERTICES,      // vertices those calls add to the rlgl batch
+    ENGINE_COUNTER_COUNT
+} EngineCounter;
+
+#ifdef NO_ENGINE_COUNTERS
+#define ENGINE_COUNT(counter, amount) ((void)0)
+#else
+#define ENGINE_COUNT(counter, amount) (engineCounters[counter] += (amount))
+#endif
+
+extern unsigned int engineCounters[ENGINE_COUNTER_COUNT];
+
+// Registers the telemetry channels; safe to call again
+void EngineCounters_Init(void);
+void EngineCounters_FrameEnd(void);
+
+const char* EngineCounters_Name(EngineCounter counter);
+// Totals of the last finished frame
+unsigned int EngineCounters_LastFrame(EngineCounter counter);
+
+#endif
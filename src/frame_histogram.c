@@ -0,0 +1,81 @@
+#include "frame_histogram.h"
+#include "raylib.h"
+#include <stdio.h>
+#include <string.h>
+
+static int FloorLog2(uint64_t v) {
+    int e = 0;
+    while (v >>= 1) e++;
+    return e;
+}
+
+static int BucketIndex(uint64_t v) {
+    if (v < FRAME_HISTOGRAM_LINEAR) return (int)v;
+    int e = FloorLog2(v);
+    if (e >= FRAME_HISTOGRAM_MAX_EXPONENT) return FRAME_HISTOGRAM_BUCKETS - 1;
+    int sub = (int)(v >> (e - 6)) - FRAME_HISTOGRAM_SUB_BUCKETS; // top 7 bits, leading one dropped
+    return FRAME_HISTOGRAM_LINEAR + (e - 7) * FRAME_HISTOGRAM_SUB_BUCKETS + sub;
+}
+
+static uint64_t BucketLow(int index) {
+    if (index < FRAME_HISTOGRAM_LINEAR) return (uint64_t)index;
+    int e = (index - FRAME_HISTOGRAM_LINEAR) / FRAME_HISTOGRAM_SUB_BUCKETS + 7;
+    int sub = (index - FRAME_HISTOGRAM_LINEAR) % FRAME_HISTOGRAM_SUB_BUCKETS;
+    return (uint64_t)(FRAME_HISTOGRAM_SUB_BUCKETS + sub) << (e - 6);
+}
+
+static uint64_t BucketHigh(int index) {
+    if (index < FRAME_HISTOGRAM_LINEAR) return (uint64_t)index;
+    int e = (index - FRAME_HISTOGRAM_LINEAR) / FRAME_HISTOGRAM_SUB_BUCKETS + 7;
+    return BucketLow(index) + ((uint64_t)1 << (e - 6)) - 1;
+}
+
+void FrameHistogram_Reset(FrameHistogram* histogram) {
+    memset(histogram, 0, sizeof(*histogram));
+}
+
+void FrameHistogram_Record(FrameHistogram* histogram, uint64_t micros) {
+    histogram->counts[BucketIndex(micros)]++;
+    histogram->total++;
+    if (micros > histogram->max) histogram->max = micros;
+}
+
+uint64_t FrameHistogram_Percentile(const FrameHistogram* histogram, double percentile) {
+    if (histogram->total == 0) return 0;
+    uint64_t rank = (uint64_t)(percentile / 100.0 * histogram->total + 0.5);
+    if (rank < 1) rank = 1;
+    if (rank > histogram->total) rank = histogram->total;
+    uint64_t seen = 0;
+    for (int i = 0; i < FRAME_HISTOGRAM_BUCKETS; i++) {
+        seen += histogram->counts[i];
+        if (seen >= rank) {
+            uint64_t high = BucketHigh(i);
+            return high < histogram->max ? high : histogram->max;
+        }
+    }
+    return histogram->max;
+}
+
+void FrameHistogram_Report(const FrameHistogram* histogram, const char* label) {
+    TraceLog(LOG_INFO, "%s: %llu samples, p50 %.2f ms, p90 %.2f ms, p99 %.2f ms, p99.9 %.2f ms, max %.2f ms",
+             label, (unsigned long long)histogram->total,
+             FrameHistogram_Percentile(histogram, 50.0) / 1000.0,
+             FrameHistogram_Percentile(histogram, 90.0) / 1000.0,
+             FrameHistogram_Percentile(histogram, 99.0) / 1000.0,
+             FrameHistogram_Percentile(histogram, 99.9) / 1000.0,
+             histogram->max / 1000.0);
+}
+
+int FrameHistogram_WriteCsv(const FrameHistogram* histogram, const char* filename) {
+    FILE* file = fopen(filename, "w");
+    if (!file) return -1;
+    fprintf(file, "low_us,high_us,count,cumulative\n");
+    uint64_t seen = 0;
+    for (int i = 0; i < FRAME_HISTOGRAM_BUCKETS; i++) {
+        if (histogram->counts[i] == 0) continue;
+        seen += histogram->counts[i];
+        fprintf(file, "%llu,%llu,%llu,%.6f\n", (unsigned long long)BucketLow(i), (unsigned long long)BucketHigh(i),
+                (unsigned long long)histogram->counts[i], (double)seen / histogram->total);
+    }
+    return fclose(file) == 0 ? 0 : -1;
+}
@@ -0,0 +1,34 @@
+#ifndef FRAME_HISTOGRAM_H
+#define FRAME_HISTOGRAM_H
+
+#include <stdint.h>
+
+// Log-bucketed (HDR-style) histogram of frame times in microseconds. Values
+// below FRAME_HISTOGRAM_LINEAR are exact; above, each power of two is split
+// into FRAME_HISTOGRAM_SUB_BUCKETS buckets, so a reported value is within
+// about 1.6% of the true one. Covers up to 2^FRAME_HISTOGRAM_MAX_EXPONENT us.
+
+#define FRAME_HISTOGRAM_LINEAR 128
+#define FRAME_HISTOGRAM_SUB_BUCKETS 64
+#define FRAME_HISTOGRAM_MAX_EXPONENT 36
+#define FRAME_HISTOGRAM_BUCKETS (FRAME_HISTOGRAM_LINEAR + (FRAME_HISTOGRAM_MAX_EXPONENT - 7) * FRAME_HISTOGRAM_SUB_BUCKETS)
+
+typedef struct {
+    uint64_t counts[FRAME_HISTOGRAM_BUCKETS];
+    uint64_t total;
+    uint64_t max;
+} FrameHistogram;
+
+void FrameHistogram_Reset(FrameHistogram* histogram);
+void FrameHistogram_Record(FrameHistogram* histogram, uint64_t micros);
+
+// Upper bound of the bucket holding the given percentile (0-100); 0 if empty
+uint64_t FrameHistogram_Percentile(const FrameHistogram* histogram, double percentile);
+
+// Logs count, p50, p90, p99, p99.9 and max with TraceLog, prefixed by label
+void FrameHistogram_Report(const FrameHistogram* histogram, const char* label);
+// One row per non-empty bucket: range, count and cumulative fraction;
+// returns 0 on success, -1 on failure
+int FrameHistogram_WriteCsv(const FrameHistogram* histogram, const char* filename);
+
+#endif
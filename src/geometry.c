@@ -0,0 +1,28 @@
+#include "geometry.h"
+#include "engine_counters.h"
+
+int orientation(Vector2 a, Vector2 b, Vector2 c) {
+    float val = (b.y - a.y) * (c.x - b.x) - (b.x - a.x) * (c.y - b.y);
+    if (val == 0.0) return 0;
+    if (val > 0) return 1;
+    return 2;
+}
+
+bool intersects(Vector2 p1, Vector2 p2, Vector2 q1, Vector2 q2) {
+    ENGINE_COUNT(COUNTER_INTERSECTS, 1);
+    int o1 = orientation(p1, p2, q1);
+    int o2 = orientation(p1, p2, q2);
+    int o3 = orientation(q1, q2, p1);
+    int o4 = orientation(q1, q2, p2);
+    return (o1 != o2) && (o3 != o4);
+}
+
+bool CollisionWithLine(Vector2 playerPos, Vector2 leftWing, Vector2 rightWing, Vector2 p1, Vector2 p2) {
+    ENGINE_COUNT(COUNTER_COLLISION_TESTS, 1);
+    if (intersects(playerPos, leftWing, p1, p2)) return true;
+    if (intersects(playerPos, rightWing, p1, p2)) return true;
+    Vector2 offPlayerPos = {playerPos.x + 10, playerPos.y + 10};
+    if (intersects(offPlayerPos, leftWing, p1, p2)) return true;
+    if (intersects(offPlayerPos, rightWing, p1, p2)) return true;
+    return false;
+}
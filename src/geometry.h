@@ -0,0 +1,17 @@
+#ifndef GEOMETRY_H
+#define GEOMETRY_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+// Segment tests used by the player collision and the editor picking
+
+// 0 when a, b and c are collinear, 1 clockwise, 2 counterclockwise
+int orientation(Vector2 a, Vector2 b, Vector2 c);
+// Whether segment p1-p2 crosses q1-q2; collinear overlaps do not count
+bool intersects(Vector2 p1, Vector2 p2, Vector2 q1, Vector2 q2);
+// Whether either wing, from playerPos or from playerPos offset by (10, 10),
+// crosses the segment p1-p2
+bool CollisionWithLine(Vector2 playerPos, Vector2 leftWing, Vector2 rightWing, Vector2 p1, Vector2 p2);
+
+#endif
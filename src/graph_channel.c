@@ -0,0 +1,99 @@
+#include "graph_channel.h"
+#include "memory_tracker.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+void GraphChannel_Free(GraphChannel* channel) {
+    MemoryTracker_Free(channel->values);
+    MemoryTracker_Free(channel->minDeque);
+    MemoryTracker_Free(channel->maxDeque);
+    MemoryTracker_Free(channel->points);
+    memset(channel, 0, sizeof(*channel));
+}
+
+void GraphChannel_Init(GraphChannel* channel, int window) {
+    memset(channel, 0, sizeof(*channel));
+    if (window < 2) window = 2;
+    channel->window = window;
+    channel->stride = (window + GRAPH_CHANNEL_MAX_POINTS - 1) / GRAPH_CHANNEL_MAX_POINTS;
+    channel->pointCount = window / channel->stride;
+    channel->values = MemoryTracker_Calloc(MEMORY_TELEMETRY, window, sizeof(float));
+    channel->minDeque = MemoryTracker_Calloc(MEMORY_TELEMETRY, window, sizeof(long long));
+    channel->maxDeque = MemoryTracker_Calloc(MEMORY_TELEMETRY, window, sizeof(long long));
+    channel->points = MemoryTracker_Calloc(MEMORY_TELEMETRY, channel->pointCount, sizeof(float));
+    if (!channel->values || !channel->minDeque || !channel->maxDeque || !channel->points) {
+        GraphChannel_Free(channel);
+        return;
+    }
+    for (int i = 0; i < window; i++) {
+        GraphChannel_Push(channel, 0.0f);
+    }
+}
+
+// Drops expired entries from the front and dominated ones from the back,
+// then appends seq; keepMin selects which deque order to maintain
+static void DequePush(const GraphChannel* channel, long long* deque, int* head, int* count, long long seq, bool keepMin) {
+    while (*count > 0 && deque[*head] <= seq - channel->window) {
+        *head = (*head + 1) % channel->window;
+        (*count)--;
+    }
+    float value = channel->values[seq % channel->window];
+    while (*count > 0) {
+        int back = (*head + *count - 1) % channel->window;
+        float backValue = channel->values[deque[back] % channel->window];
+        if (keepMin ? backValue < value : backValue > value) break;
+        (*count)--;
+    }
+    deque[(*head + *count) % channel->window] = seq;
+    (*count)++;
+}
+
+void GraphChannel_Push(GraphChannel* channel, float value) {
+    if (!channel->values) return;
+    long long seq = channel->pushed++;
+    channel->values[seq % channel->window] = value;
+    DequePush(channel, channel->minDeque, &channel->minHead, &channel->minCount, seq, true);
+    DequePush(channel, channel->maxDeque, &channel->maxHead, &channel->maxCount, seq, false);
+
+    channel->pending += value;
+    if (++channel->pendingCount == channel->stride) {
+        channel->points[channel->pointHead] = channel->pending / channel->stride;
+        channel->pointHead = (channel->pointHead + 1) % channel->pointCount;
+        channel->pending = 0.0f;
+        channel->pendingCount = 0;
+    }
+
+    float minVal = GraphChannel_Min(channel);
+    float maxVal = GraphChannel_Max(channel);
+    float range = maxVal - minVal;
+    if (range < 0.1f) range = 0.1f;
+    minVal -= range * 0.1f;
+    maxVal += range * 0.1f;
+    if (minVal != channel->displayMin || maxVal != channel->displayMax) {
+        channel->displayMin = minVal;
+        channel->displayMax = maxVal;
+        snprintf(channel->minLabel, sizeof(channel->minLabel), "%.2f", minVal);
+        snprintf(channel->maxLabel, sizeof(channel->maxLabel), "%.2f", maxVal);
+    }
+}
+
+float GraphChannel_Min(const GraphChannel* channel) {
+    if (channel->minCount == 0) return 0.0f;
+    return channel->values[channel->minDeque[channel->minHead] % channel->window];
+}
+
+float GraphChannel_Max(const GraphChannel* channel) {
+    if (channel->maxCount == 0) return 0.0f;
+    return channel->values[channel->maxDeque[channel->maxHead] % channel->window];
+}
+
+int GraphChannel_Points(const GraphChannel* channel, float* out) {
+    float range = channel->displayMax - channel->displayMin;
+    for (int i = 0; i < channel->pointCount; i++) {
+        float value = channel->points[(channel->pointHead + i) % channel->pointCount];
+        out[i] = (value - channel->displayMin) / range;
+    }
+    return channel->pointCount;
+}
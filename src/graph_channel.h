@@ -0,0 +1,47 @@
+#ifndef GRAPH_CHANNEL_H
+#define GRAPH_CHANNEL_H
+
+#include "raylib.h"
+
+// Sample history for one debug graph. Min and max over the displayed window
+// are kept by monotonic deques (O(1) amortised per sample), and the window
+// is folded into at most GRAPH_CHANNEL_MAX_POINTS averaged polyline points,
+// so drawing costs the same for a window of 50 or 5000 samples.
+
+#define GRAPH_CHANNEL_MAX_POINTS 150
+
+typedef struct {
+    int window;        // samples displayed
+    long long pushed;  // samples pushed so far; also the next sequence number
+    float* values;     // last window samples, indexed by sequence % window
+    long long* minDeque; // sequence numbers with increasing values
+    long long* maxDeque; // sequence numbers with decreasing values
+    int minHead, minCount;
+    int maxHead, maxCount;
+
+    int stride;        // samples averaged into one point
+    int pointCount;    // window / stride
+    float* points;     // ring of finished point averages
+    int pointHead;     // index of the oldest point
+    float pending;     // sum of the samples in the unfinished point
+    int pendingCount;
+
+    float displayMin;  // padded range the graph is scaled to
+    float displayMax;
+    char minLabel[16];
+    char maxLabel[16];
+} GraphChannel;
+
+// window is clamped to at least 2; the history starts filled with zeros
+void GraphChannel_Init(GraphChannel* channel, int window);
+void GraphChannel_Free(GraphChannel* channel);
+void GraphChannel_Push(GraphChannel* channel, float value);
+
+float GraphChannel_Min(const GraphChannel* channel);
+float GraphChannel_Max(const GraphChannel* channel);
+
+// Oldest to newest polyline heights in [0, 1] of the display range, at most
+// GRAPH_CHANNEL_MAX_POINTS; returns the count
+int GraphChannel_Points(const GraphChannel* channel, float* out);
+
+#endif
@@ -0,0 +1,88 @@
+#include "hud_text.h"
+#include "memory_tracker.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+void HudText_Unload(HudText* hud) {
+    if (hud->target.id != 0) {
+        MemoryTracker_Account(MEMORY_RENDER_CACHES, -MEMORY_RENDER_TEXTURE_BYTES(hud->target.texture.width, hud->target.texture.height));
+        UnloadRenderTexture(hud->target);
+    }
+    memset(hud, 0, sizeof(*hud));
+}
+
+void HudText_Begin(HudText* hud) {
+    for (int i = 0; i < HUD_TEXT_MAX_LINES; i++) {
+        hud->lines[i].used = false;
+    }
+    hud->usedCount = 0;
+}
+
+void HudText_Printf(HudText* hud, int slot, int x, int y, int fontSize, Color color, double throttle, const char* format, ...) {
+    if (slot < 0 || slot >= HUD_TEXT_MAX_LINES) return;
+    HudTextLine* line = &hud->lines[slot];
+    if (!line->used) hud->usedCount++;
+    line->used = true;
+    if (line->x != x || line->y != y || line->fontSize != fontSize || memcmp(&line->color, &color, sizeof(Color)) != 0) {
+        line->x = x;
+        line->y = y;
+        line->fontSize = fontSize;
+        line->color = color;
+        hud->dirty = true;
+    }
+    if (!line->drawn) hud->dirty = true;
+
+    double now = GetTime();
+    if (line->drawn && now - line->formattedAt < throttle) return;
+    line->formattedAt = now;
+
+    char text[HUD_TEXT_MAX_LENGTH];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    if (strcmp(text, line->text) != 0) {
+        strcpy(line->text, text);
+        hud->dirty = true;
+    }
+}
+
+void HudText_Draw(HudText* hud) {
+    if (hud->usedCount == 0) {
+        // The texture goes stale; lines submitted later re-rasterize it
+        for (int i = 0; i < HUD_TEXT_MAX_LINES; i++) {
+            hud->lines[i].drawn = false;
+        }
+        return;
+    }
+    int width = GetScreenWidth();
+    int height = GetScreenHeight();
+    if (hud->target.id == 0 || hud->target.texture.width != width || hud->target.texture.height != height) {
+        if (hud->target.id != 0) {
+            MemoryTracker_Account(MEMORY_RENDER_CACHES, -MEMORY_RENDER_TEXTURE_BYTES(hud->target.texture.width, hud->target.texture.height));
+            UnloadRenderTexture(hud->target);
+        }
+        hud->target = LoadRenderTexture(width, height);
+        MemoryTracker_Account(MEMORY_RENDER_CACHES, MEMORY_RENDER_TEXTURE_BYTES(hud->target.texture.width, hud->target.texture.height));
+        hud->dirty = true;
+    }
+    for (int i = 0; i < HUD_TEXT_MAX_LINES; i++) {
+        if (hud->lines[i].drawn && !hud->lines[i].used) hud->dirty = true;
+    }
+
+    if (hud->dirty) {
+        BeginTextureMode(hud->target);
+        ClearBackground(BLANK);
+        for (int i = 0; i < HUD_TEXT_MAX_LINES; i++) {
+            HudTextLine* line = &hud->lines[i];
+            line->drawn = line->used;
+            if (line->used) DrawText(line->text, line->x, line->y, line->fontSize, line->color);
+        }
+        EndTextureMode();
+        hud->dirty = false;
+    }
+
+    Rectangle source = { 0, 0, (float)width, -(float)height };
+    DrawTextureRec(hud->target.texture, source, (Vector2){0, 0}, WHITE);
+}
@@ -0,0 +1,44 @@
+#ifndef HUD_TEXT_H
+#define HUD_TEXT_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+// Screen-space text kept rasterized in a render texture and drawn as one
+// quad. Lines are addressed by slot and re-rasterized only when their
+// formatted text, position or visibility changes; fast-changing values can
+// be throttled so they are re-formatted at most every throttle seconds.
+
+#define HUD_TEXT_MAX_LINES 80
+#define HUD_TEXT_MAX_LENGTH 128
+#define HUD_TEXT_THROTTLE 0.1 // about 10 Hz for values that change every frame
+
+typedef struct {
+    char text[HUD_TEXT_MAX_LENGTH];
+    int x, y, fontSize;
+    Color color;
+    double formattedAt;
+    bool used;      // submitted this frame
+    bool drawn;     // present in the texture
+} HudTextLine;
+
+typedef struct {
+    RenderTexture2D target;
+    HudTextLine lines[HUD_TEXT_MAX_LINES];
+    int usedCount; // lines submitted this frame
+    bool dirty;
+} HudText;
+
+void HudText_Unload(HudText* hud);
+
+// Call once a frame before submitting lines
+void HudText_Begin(HudText* hud);
+// Lines not submitted in a frame disappear. throttle is in seconds, 0 to
+// re-format every frame
+void HudText_Printf(HudText* hud, int slot, int x, int y, int fontSize, Color color, double throttle, const char* format, ...);
+// Re-rasterizes if anything changed, then draws the text; call outside
+// BeginMode2D. Draws nothing, and allocates no texture, when no line was
+// submitted this frame
+void HudText_Draw(HudText* hud);
+
+#endif
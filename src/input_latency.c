@@ -0,0 +1,68 @@
+#include "input_latency.h"
+#include "frame_histogram.h"
+#include "raylib.h"
+
+static bool latencyEnabled;
+static bool latencyPending;  // a press is being tracked
+static bool latencyApplied;  // its state change is in the next drawn frame
+static double latencyInputTime;
+static double latencySubmitTime;
+static FrameHistogram latencyToState;
+static FrameHistogram latencyToSubmit;
+static FrameHistogram latencyToPresent;
+
+static void RecordSince(FrameHistogram* histogram, double start, double end) {
+    FrameHistogram_Record(histogram, (uint64_t)((end - start) * 1e6));
+}
+
+void InputLatency_Enable(bool enabled) {
+    latencyEnabled = enabled;
+    latencyPending = false;
+    FrameHistogram_Reset(&latencyToState);
+    FrameHistogram_Reset(&latencyToSubmit);
+    FrameHistogram_Reset(&latencyToPresent);
+}
+
+bool InputLatency_IsEnabled(void) {
+    return latencyEnabled;
+}
+
+void InputLatency_InputSeen(void) {
+    if (!latencyEnabled || latencyPending) return;
+    latencyPending = true;
+    latencyApplied = false;
+    latencyInputTime = GetTime();
+}
+
+void InputLatency_Cancel(void) {
+    latencyPending = false;
+}
+
+void InputLatency_Ticked(bool applied) {
+    if (!latencyPending || latencyApplied) return;
+    if (!applied) {
+        latencyPending = false;
+        return;
+    }
+    latencyApplied = true;
+    RecordSince(&latencyToState, latencyInputTime, GetTime());
+}
+
+void InputLatency_FrameSubmitted(void) {
+    if (!latencyPending || !latencyApplied) return;
+    latencySubmitTime = GetTime();
+    RecordSince(&latencyToSubmit, latencyInputTime, latencySubmitTime);
+}
+
+void InputLatency_FramePresented(void) {
+    if (!latencyPending || !latencyApplied) return;
+    RecordSince(&latencyToPresent, latencyInputTime, GetTime());
+    latencyPending = false;
+}
+
+void InputLatency_Report(void) {
+    if (!latencyEnabled) return;
+    FrameHistogram_Report(&latencyToState, "LATENCY: input to state change");
+    FrameHistogram_Report(&latencyToSubmit, "LATENCY: input to frame submitted");
+    FrameHistogram_Report(&latencyToPresent, "LATENCY: input to frame presented");
+}
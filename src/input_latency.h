@@ -0,0 +1,28 @@
+#ifndef INPUT_LATENCY_H
+#define INPUT_LATENCY_H
+
+#include <stdbool.h>
+
+// Input-to-photon latency measurement. A steering key press is timestamped
+// in the Update that first sees it; the first simulation tick that applies
+// it marks the state change, and the frame drawn from that state is
+// timestamped just before EndDrawing (submitted) and after it returns
+// (presented, including the buffer swap and any vsync or frame cap wait).
+// Each stage goes into a FrameHistogram, reported with InputLatency_Report.
+// One press is tracked at a time; presses the simulation never applied,
+// such as a tap released before the next tick, are dropped.
+
+void InputLatency_Enable(bool enabled);
+bool InputLatency_IsEnabled(void);
+
+void InputLatency_InputSeen(void);
+// Stops tracking the current press, e.g. when the simulation pauses
+void InputLatency_Cancel(void);
+// After every simulation tick; applied is whether the tick saw the input
+void InputLatency_Ticked(bool applied);
+void InputLatency_FrameSubmitted(void);
+void InputLatency_FramePresented(void);
+
+void InputLatency_Report(void);
+
+#endif
@@ -0,0 +1,71 @@
+#include "layer_cache.h"
+#include "memory_tracker.h"
+#include <math.h>
+#include <string.h>
+
+void LayerCache_Unload(LayerCache* cache) {
+    if (cache->target.id != 0) {
+        MemoryTracker_Account(MEMORY_RENDER_CACHES, -MEMORY_RENDER_TEXTURE_BYTES(cache->target.texture.width, cache->target.texture.height));
+        UnloadRenderTexture(cache->target);
+    }
+    memset(cache, 0, sizeof(*cache));
+}
+
+void LayerCache_Invalidate(LayerCache* cache) {
+    cache->valid = false;
+}
+
+// Where the cached texture's top-left corner lands on screen for view
+static Vector2 CachedOrigin(const LayerCache* cache, Camera2D view) {
+    Vector2 anchor = GetWorldToScreen2D(cache->cachedView.target, view);
+    return (Vector2){ anchor.x - cache->cachedView.offset.x, anchor.y - cache->cachedView.offset.y };
+}
+
+bool LayerCache_NeedsRedraw(const LayerCache* cache, Camera2D view, int viewWidth, int viewHeight, unsigned int revision) {
+    if (!cache->valid || cache->revision != revision) return true;
+    if (cache->viewWidth != viewWidth || cache->viewHeight != viewHeight) return true;
+    if (cache->cachedView.zoom != view.zoom || cache->cachedView.rotation != view.rotation) return true;
+    if (cache->cachedView.offset.x != view.offset.x || cache->cachedView.offset.y != view.offset.y) return true;
+    // The view has scrolled by -origin; redraw once that exceeds the margin
+    Vector2 origin = CachedOrigin(cache, view);
+    return fabsf(origin.x) > LAYER_CACHE_MARGIN || fabsf(origin.y) > LAYER_CACHE_MARGIN;
+}
+
+Camera2D LayerCache_Begin(LayerCache* cache, Camera2D view, int viewWidth, int viewHeight, unsigned int revision) {
+    if (cache->viewWidth != viewWidth || cache->viewHeight != viewHeight || cache->target.id == 0) {
+        if (cache->target.id != 0) {
+            MemoryTracker_Account(MEMORY_RENDER_CACHES, -MEMORY_RENDER_TEXTURE_BYTES(cache->target.texture.width, cache->target.texture.height));
+            UnloadRenderTexture(cache->target);
+        }
+        cache->target = LoadRenderTexture(viewWidth + 2 * LAYER_CACHE_MARGIN, viewHeight + 2 * LAYER_CACHE_MARGIN);
+        MemoryTracker_Account(MEMORY_RENDER_CACHES, MEMORY_RENDER_TEXTURE_BYTES(cache->target.texture.width, cache->target.texture.height));
+        cache->viewWidth = viewWidth;
+        cache->viewHeight = viewHeight;
+    }
+    // The cache camera keeps the current target at the same spot, shifted
+    // by the margin; view.offset is kept so NeedsRedraw can compare it
+    cache->cachedView = view;
+    cache->revision = revision;
+    cache->valid = true;
+
+    Camera2D cacheCamera = view;
+    cacheCamera.offset.x += LAYER_CACHE_MARGIN;
+    cacheCamera.offset.y += LAYER_CACHE_MARGIN;
+
+    BeginTextureMode(cache->target);
+    ClearBackground(BLANK);
+    return cacheCamera;
+}
+
+void LayerCache_End(LayerCache* cache) {
+    (void)cache;
+    EndTextureMode();
+}
+
+void LayerCache_Draw(const LayerCache* cache, Camera2D view) {
+    if (!cache->valid) return;
+    Vector2 origin = CachedOrigin(cache, view);
+    Vector2 position = { roundf(origin.x) - LAYER_CACHE_MARGIN, roundf(origin.y) - LAYER_CACHE_MARGIN };
+    Rectangle source = { 0, 0, (float)cache->target.texture.width, -(float)cache->target.texture.height };
+    DrawTextureRec(cache->target.texture, source, position, WHITE);
+}
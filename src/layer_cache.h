@@ -0,0 +1,37 @@
+#ifndef LAYER_CACHE_H
+#define LAYER_CACHE_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+// Caches a static world-space layer in a render texture covering the view
+// plus a margin on every side. The layer is redrawn only when the camera
+// scrolls past the margin, zoom or rotation change, the view is resized or
+// the content revision changes; other frames composite one textured quad.
+
+#define LAYER_CACHE_MARGIN 128
+
+typedef struct {
+    RenderTexture2D target;
+    int viewWidth;
+    int viewHeight;
+    Camera2D cachedView; // camera the texture was drawn with
+    unsigned int revision;
+    bool valid;
+} LayerCache;
+
+void LayerCache_Unload(LayerCache* cache);
+void LayerCache_Invalidate(LayerCache* cache);
+
+bool LayerCache_NeedsRedraw(const LayerCache* cache, Camera2D view, int viewWidth, int viewHeight, unsigned int revision);
+
+// Begins drawing the layer into the cache; returns the camera to draw with
+// (the texture is viewWidth + 2 * LAYER_CACHE_MARGIN wide). Call outside
+// BeginMode2D.
+Camera2D LayerCache_Begin(LayerCache* cache, Camera2D view, int viewWidth, int viewHeight, unsigned int revision);
+void LayerCache_End(LayerCache* cache);
+
+// Composites the cached layer in screen space, outside BeginMode2D
+void LayerCache_Draw(const LayerCache* cache, Camera2D view);
+
+#endif
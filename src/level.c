@@ -0,0 +1,138 @@
+#include "level.h"
+#include "segment_pack.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef EMBED_LEVELS
+#include "levels_embedded.h"
+
+// Level baked into the executable under filename, if any
+static const Level* FindEmbeddedLevel(const char* filename) {
+    for (int i = 0; i < EMBEDDED_LEVEL_COUNT; i++) {
+        if (strcmp(embeddedLevelNames[i], filename) == 0) return &embeddedLevels[i];
+    }
+    return NULL;
+}
+#endif
+
+#define PACKED_LEVEL_MAGIC 0x324C5746u // "FWL2"
+
+// Level files are either a raw Level (sizeof(Level) bytes, the original
+// format) or this header followed by SegmentPack data.
+typedef struct {
+    uint32_t magic;
+    int32_t segmentCount;
+    Vector2 origin;
+    Vector2 goal;
+    uint32_t payloadSize;
+} PackedLevelHeader;
+
+#define LEVEL_FILE_MAX_BYTES (sizeof(PackedLevelHeader) + SEGMENT_PACK_MAX_BYTES(MAX_SEGMENTS))
+
+static Vector2 PackOrigin(const Level* level) {
+    if (level->segmentCount == 0) return (Vector2){0};
+    float minX = level->segments[0].start.x, maxX = minX;
+    float minY = level->segments[0].start.y, maxY = minY;
+    for (int i = 0; i < level->segmentCount; i++) {
+        const LineSegment* s = &level->segments[i];
+        minX = fminf(minX, fminf(s->start.x, s->end.x));
+        maxX = fmaxf(maxX, fmaxf(s->start.x, s->end.x));
+        minY = fminf(minY, fminf(s->start.y, s->end.y));
+        maxY = fmaxf(maxY, fmaxf(s->start.y, s->end.y));
+    }
+    return (Vector2){ floorf((minX + maxX) / 2), floorf((minY + maxY) / 2) };
+}
+
+// Writes the level next to its destination and renames it into place, so a
+// crash mid-write leaves the previous file intact. The level is normalized
+// in place (coordinates snapped to the packed grid, unused slots cleared) so
+// it compares equal to what load_level returns. Levels too large for the
+// packed format are written raw.
+int save_level(Level* level, const char* filename) {
+    unsigned char buffer[LEVEL_FILE_MAX_BYTES];
+    size_t size = 0;
+
+    memset(&level->segments[level->segmentCount], 0, (MAX_SEGMENTS - level->segmentCount) * sizeof(LineSegment));
+    Vector2 origin = PackOrigin(level);
+    size_t payloadSize = SegmentPack_Encode(level->segments, level->segmentCount, origin,
+                                            buffer + sizeof(PackedLevelHeader), SEGMENT_PACK_MAX_BYTES(MAX_SEGMENTS));
+    if (payloadSize > 0 || level->segmentCount == 0) {
+        SegmentPack_Snap(level->segments, level->segmentCount, origin);
+        PackedLevelHeader header = { PACKED_LEVEL_MAGIC, level->segmentCount, origin, level->goal, (uint32_t)payloadSize };
+        memcpy(buffer, &header, sizeof(header));
+        size = sizeof(header) + payloadSize;
+    }
+
+    char tmpName[256];
+    snprintf(tmpName, sizeof(tmpName), "%s.tmp", filename);
+    FILE* file = fopen(tmpName, "wb");
+    if (!file) return -1;
+    size_t written = size > 0 ? fwrite(buffer, size, 1, file) : fwrite(level, sizeof(Level), 1, file);
+    fflush(file);
+    fsync(fileno(file));
+    fclose(file);
+    if (written != 1) {
+        remove(tmpName);
+        return -1;
+    }
+    return rename(tmpName, filename) == 0 ? 0 : -1;
+}
+
+static int DecodePackedLevel(Level* level, const unsigned char* data, size_t size) {
+    PackedLevelHeader header;
+    if (size < sizeof(header)) return -1;
+    memcpy(&header, data, sizeof(header));
+    if (header.magic != PACKED_LEVEL_MAGIC || header.segmentCount < 0 || header.segmentCount > MAX_SEGMENTS ||
+        header.payloadSize > size - sizeof(header)) {
+        return -1;
+    }
+    memset(level, 0, sizeof(Level));
+    if (SegmentPack_Decode(data + sizeof(header), header.payloadSize, header.origin,
+                           level->segments, header.segmentCount) != 0) {
+        memset(level, 0, sizeof(Level));
+        return -1;
+    }
+    level->segmentCount = header.segmentCount;
+    level->goal = header.goal;
+    return 0;
+}
+
+// A file on disk takes precedence over an embedded level so edits stay visible
+int load_level(Level* level, const char* filename) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+#ifdef EMBED_LEVELS
+        const Level* embedded = FindEmbeddedLevel(filename);
+        if (embedded) {
+            *level = *embedded;
+            return 0;
+        }
+#endif
+        memset(level, 0, sizeof(Level));
+        return 0;
+    }
+    unsigned char buffer[sizeof(Level) + 1];
+    size_t size = fread(buffer, 1, sizeof(buffer), file);
+    fclose(file);
+    if (size == sizeof(Level)) {
+        memcpy(level, buffer, sizeof(Level));
+    } else if (DecodePackedLevel(level, buffer, size) != 0) {
+        memset(level, 0, sizeof(Level));
+    }
+    return 0;
+}
+
+// CRC-32 (IEEE), bitwise; only used on small records and level snapshots
+uint32_t level_checksum(const void* data, size_t size) {
+    const unsigned char* bytes = data;
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; i++) {
+        crc ^= bytes[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
@@ -0,0 +1,25 @@
+#ifndef LEVEL_H
+#define LEVEL_H
+
+#include "raylib.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define MAX_SEGMENTS 100
+
+typedef struct {
+    Vector2 start;
+    Vector2 end;
+} LineSegment;
+
+typedef struct {
+    LineSegment segments[MAX_SEGMENTS];
+    int segmentCount;
+    Vector2 goal;
+} Level;
+
+int save_level(Level* level, const char* filename);
+int load_level(Level* level, const char* filename);
+uint32_t level_checksum(const void* data, size_t size);
+
+#endif
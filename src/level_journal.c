@@ -0,0 +1,275 @@
+#include "level_journal.h"
+#include "profiler.h"
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define JOURNAL_MAGIC 0x314A5746u // "FWJ1"
+
+enum JournalOp {
+    JOURNAL_OP_ADD_SEGMENT = 1,
+    JOURNAL_OP_REMOVE_SEGMENT,
+    JOURNAL_OP_SET_GOAL,
+    JOURNAL_OP_COMPACT // queue only, never written to the file
+};
+
+typedef struct {
+    uint32_t magic;
+    uint32_t baseChecksum; // checksum of the level file the records apply to
+} JournalHeader;
+
+typedef struct {
+    uint32_t op;
+    int32_t index;
+    LineSegment segment; // ADD: the segment, SET_GOAL: segment.start
+    uint32_t checksum;
+} JournalRecord;
+
+static pthread_t journalThread;
+static pthread_mutex_t journalMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t journalWork = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t journalChanged = PTHREAD_COND_INITIALIZER;
+static JournalRecord journalQueue[JOURNAL_QUEUE_SIZE];
+static int journalHead;
+static int journalCount;
+static bool journalRunning;
+static bool journalBusy;
+
+// Owned by the writer thread; the main thread only touches them in
+// LevelJournal_Open while the writer is idle and the mutex is held.
+static char journalLevelFile[256];
+static char journalFileName[264];
+static uint32_t journalBaseChecksum;
+static Level journalShadow;
+static FILE* journalFile;
+static int journalPendingRecords;
+
+static uint32_t RecordChecksum(const JournalRecord* record) {
+    return level_checksum(record, offsetof(JournalRecord, checksum));
+}
+
+static void ApplyRecord(Level* level, const JournalRecord* record) {
+    switch (record->op) {
+        case JOURNAL_OP_ADD_SEGMENT:
+            if (level->segmentCount < MAX_SEGMENTS) {
+                level->segments[level->segmentCount++] = record->segment;
+            }
+            break;
+        case JOURNAL_OP_REMOVE_SEGMENT:
+            if (record->index >= 0 && record->index < level->segmentCount) {
+                level->segments[record->index] = level->segments[level->segmentCount - 1];
+                level->segmentCount--;
+            }
+            break;
+        case JOURNAL_OP_SET_GOAL:
+            level->goal = record->segment.start;
+            break;
+        default:
+            break;
+    }
+}
+
+// Applies the records of a journal written against baseChecksum; stops at the
+// first torn or corrupt record. Returns the number of records applied.
+static int ReplayJournal(Level* level, const char* filename, uint32_t baseChecksum) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) return 0;
+    int applied = 0;
+    JournalHeader header;
+    if (fread(&header, sizeof(header), 1, file) == 1 &&
+        header.magic == JOURNAL_MAGIC && header.baseChecksum == baseChecksum) {
+        JournalRecord record;
+        while (fread(&record, sizeof(record), 1, file) == 1) {
+            if (record.checksum != RecordChecksum(&record)) break;
+            ApplyRecord(level, &record);
+            applied++;
+        }
+    }
+    fclose(file);
+    return applied;
+}
+
+static void CompactJournal(void) {
+    if (journalLevelFile[0] == '\0') return;
+    if (save_level(&journalShadow, journalLevelFile) != 0) return;
+    journalBaseChecksum = level_checksum(&journalShadow, sizeof(Level));
+    if (journalFile) {
+        fclose(journalFile);
+        journalFile = NULL;
+    }
+    remove(journalFileName);
+    journalPendingRecords = 0;
+}
+
+static void AppendRecord(const JournalRecord* record) {
+    if (journalLevelFile[0] == '\0') return;
+    if (!journalFile) {
+        journalFile = fopen(journalFileName, "wb");
+        if (!journalFile) return;
+        JournalHeader header = { JOURNAL_MAGIC, journalBaseChecksum };
+        fwrite(&header, sizeof(header), 1, journalFile);
+    }
+    fwrite(record, sizeof(*record), 1, journalFile);
+    fflush(journalFile);
+    fsync(fileno(journalFile));
+
+    ApplyRecord(&journalShadow, record);
+    journalPendingRecords++;
+    if (journalPendingRecords >= JOURNAL_COMPACT_RECORDS) {
+        CompactJournal();
+    }
+}
+
+static void* JournalThread(void* arg) {
+    (void)arg;
+    PROFILE_THREAD_NAME("journal writer");
+    pthread_mutex_lock(&journalMutex);
+    while (true) {
+        if (journalCount == 0) {
+            if (!journalRunning) break;
+            if (journalPendingRecords > 0) {
+                struct timespec deadline;
+                clock_gettime(CLOCK_REALTIME, &deadline);
+                deadline.tv_sec += JOURNAL_COMPACT_IDLE_SECONDS;
+                int result = pthread_cond_timedwait(&journalWork, &journalMutex, &deadline);
+                if (result == ETIMEDOUT && journalCount == 0) {
+                    journalBusy = true;
+                    pthread_mutex_unlock(&journalMutex);
+                    uint64_t zoneStart = PROFILE_NOW();
+                    CompactJournal();
+                    PROFILE_THREAD_ZONE("CompactJournal", zoneStart);
+                    pthread_mutex_lock(&journalMutex);
+                    journalBusy = false;
+                    pthread_cond_broadcast(&journalChanged);
+                }
+            } else {
+                pthread_cond_wait(&journalWork, &journalMutex);
+            }
+            continue;
+        }
+
+        JournalRecord record = journalQueue[journalHead];
+        journalHead = (journalHead + 1) % JOURNAL_QUEUE_SIZE;
+        journalCount--;
+        journalBusy = true;
+        pthread_mutex_unlock(&journalMutex);
+
+        uint64_t zoneStart = PROFILE_NOW();
+        if (record.op == JOURNAL_OP_COMPACT) {
+            CompactJournal();
+            PROFILE_THREAD_ZONE("CompactJournal", zoneStart);
+        } else {
+            AppendRecord(&record);
+            PROFILE_THREAD_ZONE("AppendRecord", zoneStart);
+        }
+
+        pthread_mutex_lock(&journalMutex);
+        journalBusy = false;
+        pthread_cond_broadcast(&journalChanged);
+    }
+    if (journalPendingRecords > 0) {
+        CompactJournal();
+    }
+    pthread_mutex_unlock(&journalMutex);
+    return NULL;
+}
+
+// Caller holds journalMutex
+static void EnqueueLocked(JournalRecord record) {
+    record.checksum = RecordChecksum(&record);
+    while (journalCount == JOURNAL_QUEUE_SIZE) {
+        pthread_cond_wait(&journalChanged, &journalMutex);
+    }
+    journalQueue[(journalHead + journalCount) % JOURNAL_QUEUE_SIZE] = record;
+    journalCount++;
+    pthread_cond_signal(&journalWork);
+}
+
+static void Enqueue(JournalRecord record) {
+    pthread_mutex_lock(&journalMutex);
+    if (journalRunning) {
+        EnqueueLocked(record);
+    }
+    pthread_mutex_unlock(&journalMutex);
+}
+
+void LevelJournal_Start(void) {
+    pthread_mutex_lock(&journalMutex);
+    journalHead = 0;
+    journalCount = 0;
+    journalRunning = true;
+    pthread_mutex_unlock(&journalMutex);
+    pthread_create(&journalThread, NULL, JournalThread, NULL);
+}
+
+void LevelJournal_Stop(void) {
+    pthread_mutex_lock(&journalMutex);
+    if (!journalRunning) {
+        pthread_mutex_unlock(&journalMutex);
+        return;
+    }
+    journalRunning = false;
+    pthread_cond_signal(&journalWork);
+    pthread_mutex_unlock(&journalMutex);
+    pthread_join(journalThread, NULL);
+
+    if (journalFile) {
+        fclose(journalFile);
+        journalFile = NULL;
+    }
+    journalLevelFile[0] = '\0';
+}
+
+int LevelJournal_Open(Level* level, const char* filename) {
+    pthread_mutex_lock(&journalMutex);
+    while (journalCount > 0 || journalBusy) {
+        pthread_cond_wait(&journalChanged, &journalMutex);
+    }
+    // The writer is idle now, so its state is safe to read and compact here
+    if (journalPendingRecords > 0) {
+        CompactJournal();
+    }
+    if (journalFile) {
+        fclose(journalFile);
+        journalFile = NULL;
+    }
+
+    load_level(level, filename);
+    snprintf(journalLevelFile, sizeof(journalLevelFile), "%s", filename);
+    snprintf(journalFileName, sizeof(journalFileName), "%s.journal", journalLevelFile);
+    journalBaseChecksum = level_checksum(level, sizeof(Level));
+
+    // Recover edits from a session that ended before compacting
+    int recovered = ReplayJournal(level, journalFileName, journalBaseChecksum);
+    if (recovered == 0) {
+        remove(journalFileName);
+    } else if (save_level(level, filename) == 0) {
+        journalBaseChecksum = level_checksum(level, sizeof(Level));
+        remove(journalFileName);
+    }
+    journalShadow = *level;
+    journalPendingRecords = 0;
+    pthread_mutex_unlock(&journalMutex);
+    return 0;
+}
+
+void LevelJournal_AddSegment(LineSegment segment) {
+    Enqueue((JournalRecord){ .op = JOURNAL_OP_ADD_SEGMENT, .segment = segment });
+}
+
+void LevelJournal_RemoveSegment(int index) {
+    Enqueue((JournalRecord){ .op = JOURNAL_OP_REMOVE_SEGMENT, .index = index });
+}
+
+void LevelJournal_SetGoal(Vector2 goal) {
+    Enqueue((JournalRecord){ .op = JOURNAL_OP_SET_GOAL, .segment = { goal, goal } });
+}
+
+void LevelJournal_Compact(void) {
+    Enqueue((JournalRecord){ .op = JOURNAL_OP_COMPACT });
+}
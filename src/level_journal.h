@@ -0,0 +1,28 @@
+#ifndef LEVEL_JOURNAL_H
+#define LEVEL_JOURNAL_H
+
+#include "level.h"
+
+// Write-ahead journal for level edits. Edits are appended to "<level>.journal"
+// by a background writer thread, which folds them into the level file
+// (write to a temp file, then rename) every JOURNAL_COMPACT_RECORDS records,
+// after JOURNAL_COMPACT_IDLE_SECONDS without edits, on request, and when
+// switching levels.
+
+#define JOURNAL_QUEUE_SIZE 256
+#define JOURNAL_COMPACT_RECORDS 64
+#define JOURNAL_COMPACT_IDLE_SECONDS 2
+
+void LevelJournal_Start(void);
+void LevelJournal_Stop(void);
+
+// Loads filename plus any journal left behind by a previous session into
+// level and makes it the target of subsequent edits.
+int LevelJournal_Open(Level* level, const char* filename);
+
+void LevelJournal_AddSegment(LineSegment segment);
+void LevelJournal_RemoveSegment(int index);
+void LevelJournal_SetGoal(Vector2 goal);
+void LevelJournal_Compact(void);
+
+#endif
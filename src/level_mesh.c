@@ -0,0 +1,93 @@
+#include "level_mesh.h"
+#include "memory_tracker.h"
+#include "raymath.h"
+#include <math.h>
+#include <string.h>
+
+#define FLOATS_PER_SEGMENT (LEVEL_MESH_VERTICES_PER_SEGMENT * 3)
+// Positions, texcoords and colors, kept in RAM and in the vertex buffers
+#define BYTES_PER_SEGMENT (LEVEL_MESH_VERTICES_PER_SEGMENT * (3 * sizeof(float) + 2 * sizeof(float) + 4) * 2)
+
+// Same corners and triangles as DrawLineEx/DrawTriangleStrip, which emits
+// (2, 0, 1) then (3, 2, 1); both wind the same way, so back-face culling
+// keeps them and coverage matches the immediate-mode path
+static void TessellateSegment(float* out, LineSegment segment, float thickness) {
+    Vector2 delta = Vector2Subtract(segment.end, segment.start);
+    float length = Vector2Length(delta);
+    if (length <= 0.0f) {
+        memset(out, 0, FLOATS_PER_SEGMENT * sizeof(float));
+        return;
+    }
+    float scale = thickness / (2 * length);
+    Vector2 radius = { -scale * delta.y, scale * delta.x };
+    Vector2 strip[4] = {
+        Vector2Subtract(segment.start, radius),
+        Vector2Add(segment.start, radius),
+        Vector2Subtract(segment.end, radius),
+        Vector2Add(segment.end, radius)
+    };
+    const int order[LEVEL_MESH_VERTICES_PER_SEGMENT] = { 2, 0, 1, 3, 2, 1 };
+    for (int v = 0; v < LEVEL_MESH_VERTICES_PER_SEGMENT; v++) {
+        out[v * 3 + 0] = strip[order[v]].x;
+        out[v * 3 + 1] = strip[order[v]].y;
+        out[v * 3 + 2] = 0.0f;
+    }
+}
+
+void LevelMesh_Load(LevelMesh* levelMesh, int capacity, float thickness, Color color) {
+    memset(levelMesh, 0, sizeof(*levelMesh));
+    levelMesh->capacity = capacity;
+    levelMesh->thickness = thickness;
+
+    Mesh* mesh = &levelMesh->mesh;
+    mesh->vertexCount = capacity * LEVEL_MESH_VERTICES_PER_SEGMENT;
+    mesh->triangleCount = capacity * 2;
+    mesh->vertices = MemAlloc(mesh->vertexCount * 3 * sizeof(float));
+    mesh->texcoords = MemAlloc(mesh->vertexCount * 2 * sizeof(float));
+    mesh->colors = MemAlloc(mesh->vertexCount * 4);
+    for (int v = 0; v < mesh->vertexCount; v++) {
+        memcpy(&mesh->colors[v * 4], &color, 4);
+    }
+    UploadMesh(mesh, true);
+    MemoryTracker_Account(MEMORY_RENDER_CACHES, (long long)capacity * BYTES_PER_SEGMENT);
+    levelMesh->material = LoadMaterialDefault();
+}
+
+void LevelMesh_Unload(LevelMesh* levelMesh) {
+    if (levelMesh->capacity == 0) return;
+    UnloadMesh(levelMesh->mesh);
+    MemoryTracker_Account(MEMORY_RENDER_CACHES, -(long long)levelMesh->capacity * BYTES_PER_SEGMENT);
+    UnloadMaterial(levelMesh->material);
+    memset(levelMesh, 0, sizeof(*levelMesh));
+}
+
+void LevelMesh_SetSegments(LevelMesh* levelMesh, const LineSegment* segments, int count) {
+    if (count > levelMesh->capacity) count = levelMesh->capacity;
+    for (int i = 0; i < count; i++) {
+        TessellateSegment(&levelMesh->mesh.vertices[i * FLOATS_PER_SEGMENT], segments[i], levelMesh->thickness);
+    }
+    if (count > 0) {
+        UpdateMeshBuffer(levelMesh->mesh, 0, levelMesh->mesh.vertices, count * FLOATS_PER_SEGMENT * sizeof(float), 0);
+    }
+    levelMesh->segmentCount = count;
+}
+
+void LevelMesh_SetSegment(LevelMesh* levelMesh, int index, LineSegment segment) {
+    if (index < 0 || index >= levelMesh->capacity) return;
+    float* vertices = &levelMesh->mesh.vertices[index * FLOATS_PER_SEGMENT];
+    TessellateSegment(vertices, segment, levelMesh->thickness);
+    UpdateMeshBuffer(levelMesh->mesh, 0, vertices, FLOATS_PER_SEGMENT * sizeof(float),
+                     index * FLOATS_PER_SEGMENT * sizeof(float));
+}
+
+void LevelMesh_SetCount(LevelMesh* levelMesh, int count) {
+    levelMesh->segmentCount = count < levelMesh->capacity ? count : levelMesh->capacity;
+}
+
+void LevelMesh_Draw(const LevelMesh* levelMesh) {
+    if (levelMesh->segmentCount == 0) return;
+    Mesh mesh = levelMesh->mesh;
+    mesh.vertexCount = levelMesh->segmentCount * LEVEL_MESH_VERTICES_PER_SEGMENT;
+    mesh.triangleCount = levelMesh->segmentCount * 2;
+    DrawMesh(mesh, levelMesh->material, MatrixIdentity());
+}
@@ -0,0 +1,30 @@
+#ifndef LEVEL_MESH_H
+#define LEVEL_MESH_H
+
+#include "level.h"
+
+// Level segments tessellated into thick-line quads (the same geometry
+// DrawLineEx produces) and kept in one dynamic GPU vertex buffer, drawn with
+// a single call. Edits re-upload only the vertices of the touched segment.
+
+#define LEVEL_MESH_VERTICES_PER_SEGMENT 6
+
+typedef struct {
+    Mesh mesh;
+    Material material;
+    int capacity;
+    int segmentCount;
+    float thickness;
+} LevelMesh;
+
+void LevelMesh_Load(LevelMesh* levelMesh, int capacity, float thickness, Color color);
+void LevelMesh_Unload(LevelMesh* levelMesh);
+
+void LevelMesh_SetSegments(LevelMesh* levelMesh, const LineSegment* segments, int count);
+void LevelMesh_SetSegment(LevelMesh* levelMesh, int index, LineSegment segment);
+void LevelMesh_SetCount(LevelMesh* levelMesh, int count);
+
+// Call inside BeginMode2D
+void LevelMesh_Draw(const LevelMesh* levelMesh);
+
+#endif
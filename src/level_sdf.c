@@ -0,0 +1,109 @@
+#include "level_sdf.h"
+#include "memory_tracker.h"
+#include <string.h>
+
+static const char* levelSdfFragment =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "out vec4 finalColor;\n"
+    "uniform sampler2D primitives;\n"
+    "uniform int count;\n"
+    "uniform vec2 origin;\n"
+    "uniform vec2 axisX;\n"
+    "uniform vec2 axisY;\n"
+    "uniform float screenHeight;\n"
+    "void main() {\n"
+    "    vec2 screen = vec2(gl_FragCoord.x, screenHeight - gl_FragCoord.y);\n"
+    "    vec2 p = origin + axisX * screen.x + axisY * screen.y;\n"
+    "    float pixel = length(axisX);\n"
+    "    vec4 color = vec4(0.0);\n"
+    "    for (int i = 0; i < count; i++) {\n"
+    "        vec4 line = texelFetch(primitives, ivec2(i, 0), 0);\n"
+    "        vec4 style = texelFetch(primitives, ivec2(i, 1), 0);\n"
+    "        vec2 pa = p - line.xy;\n"
+    "        vec2 ba = line.zw - line.xy;\n"
+    "        float h = clamp(dot(pa, ba) / max(dot(ba, ba), 1e-6), 0.0, 1.0);\n"
+    "        float d = length(pa - ba * h) - style.x;\n"
+    "        float coverage = clamp(0.5 - d / pixel, 0.0, 1.0);\n"
+    "        color = mix(color, vec4(style.yzw, 1.0), coverage);\n"
+    "    }\n"
+    "    if (color.a <= 0.0) discard;\n"
+    "    finalColor = vec4(color.rgb / color.a, color.a);\n"
+    "}\n";
+
+void LevelSdf_Load(LevelSdf* sdf) {
+    memset(sdf, 0, sizeof(*sdf));
+    sdf->data = MemoryTracker_Calloc(MEMORY_RENDER_CACHES, 2 * LEVEL_SDF_MAX_PRIMITIVES * 4, sizeof(float));
+    Image image = {
+        .data = sdf->data,
+        .width = LEVEL_SDF_MAX_PRIMITIVES,
+        .height = 2,
+        .mipmaps = 1,
+        .format = PIXELFORMAT_UNCOMPRESSED_R32G32B32A32
+    };
+    sdf->primitives = LoadTextureFromImage(image);
+    MemoryTracker_Account(MEMORY_RENDER_CACHES, 2 * LEVEL_SDF_MAX_PRIMITIVES * 4 * sizeof(float));
+    sdf->shader = LoadShaderFromMemory(NULL, levelSdfFragment);
+    sdf->primitivesLoc = GetShaderLocation(sdf->shader, "primitives");
+    sdf->countLoc = GetShaderLocation(sdf->shader, "count");
+    sdf->originLoc = GetShaderLocation(sdf->shader, "origin");
+    sdf->axisXLoc = GetShaderLocation(sdf->shader, "axisX");
+    sdf->axisYLoc = GetShaderLocation(sdf->shader, "axisY");
+    sdf->screenHeightLoc = GetShaderLocation(sdf->shader, "screenHeight");
+}
+
+void LevelSdf_Unload(LevelSdf* sdf) {
+    if (!sdf->data) return;
+    UnloadShader(sdf->shader);
+    UnloadTexture(sdf->primitives);
+    MemoryTracker_Account(MEMORY_RENDER_CACHES, -(long long)(2 * LEVEL_SDF_MAX_PRIMITIVES * 4 * sizeof(float)));
+    MemoryTracker_Free(sdf->data);
+    memset(sdf, 0, sizeof(*sdf));
+}
+
+void LevelSdf_Clear(LevelSdf* sdf) {
+    sdf->count = 0;
+}
+
+void LevelSdf_AddLine(LevelSdf* sdf, Vector2 start, Vector2 end, float thickness, Color color) {
+    if (sdf->count == LEVEL_SDF_MAX_PRIMITIVES) return;
+    float* line = &sdf->data[sdf->count * 4];
+    float* style = &sdf->data[(LEVEL_SDF_MAX_PRIMITIVES + sdf->count) * 4];
+    line[0] = start.x;
+    line[1] = start.y;
+    line[2] = end.x;
+    line[3] = end.y;
+    style[0] = thickness / 2;
+    style[1] = color.r / 255.0f;
+    style[2] = color.g / 255.0f;
+    style[3] = color.b / 255.0f;
+    sdf->count++;
+}
+
+void LevelSdf_AddCircle(LevelSdf* sdf, Vector2 center, float radius, Color color) {
+    LevelSdf_AddLine(sdf, center, center, 2 * radius, color);
+}
+
+void LevelSdf_Draw(LevelSdf* sdf, Camera2D view, int width, int height, int targetHeight) {
+    if (sdf->count == 0) return;
+    UpdateTexture(sdf->primitives, sdf->data);
+
+    // Screen-to-world is affine: world = origin + axisX * x + axisY * y
+    Vector2 origin = GetScreenToWorld2D((Vector2){0, 0}, view);
+    Vector2 unitX = GetScreenToWorld2D((Vector2){1, 0}, view);
+    Vector2 unitY = GetScreenToWorld2D((Vector2){0, 1}, view);
+    Vector2 axisX = { unitX.x - origin.x, unitX.y - origin.y };
+    Vector2 axisY = { unitY.x - origin.x, unitY.y - origin.y };
+    float screenHeight = (float)targetHeight; // gl_FragCoord counts up from the bottom
+
+    BeginShaderMode(sdf->shader);
+    SetShaderValueTexture(sdf->shader, sdf->primitivesLoc, sdf->primitives);
+    SetShaderValue(sdf->shader, sdf->countLoc, &sdf->count, SHADER_UNIFORM_INT);
+    SetShaderValue(sdf->shader, sdf->originLoc, &origin, SHADER_UNIFORM_VEC2);
+    SetShaderValue(sdf->shader, sdf->axisXLoc, &axisX, SHADER_UNIFORM_VEC2);
+    SetShaderValue(sdf->shader, sdf->axisYLoc, &axisY, SHADER_UNIFORM_VEC2);
+    SetShaderValue(sdf->shader, sdf->screenHeightLoc, &screenHeight, SHADER_UNIFORM_FLOAT);
+    DrawRectangle(0, 0, width, height, WHITE);
+    EndShaderMode();
+}
@@ -0,0 +1,41 @@
+#ifndef LEVEL_SDF_H
+#define LEVEL_SDF_H
+
+#include "raylib.h"
+
+// Thick lines and filled circles drawn by one full-screen fragment shader
+// that evaluates the distance to every primitive, giving anti-aliased edges
+// and a constant draw call count. Primitives live in a float texture: row 0
+// holds the endpoints, row 1 the half thickness and colour. A circle is a
+// zero-length line whose half thickness is the radius.
+
+#define LEVEL_SDF_MAX_PRIMITIVES 1024
+
+typedef struct {
+    Shader shader;
+    Texture2D primitives;
+    float* data; // 2 rows of LEVEL_SDF_MAX_PRIMITIVES RGBA32F texels
+    int count;
+    int primitivesLoc;
+    int countLoc;
+    int originLoc;
+    int axisXLoc;
+    int axisYLoc;
+    int screenHeightLoc;
+} LevelSdf;
+
+void LevelSdf_Load(LevelSdf* sdf);
+void LevelSdf_Unload(LevelSdf* sdf);
+
+// Primitives are in world space and drawn in the order added; anything past
+// LEVEL_SDF_MAX_PRIMITIVES is dropped
+void LevelSdf_Clear(LevelSdf* sdf);
+void LevelSdf_AddLine(LevelSdf* sdf, Vector2 start, Vector2 end, float thickness, Color color);
+void LevelSdf_AddCircle(LevelSdf* sdf, Vector2 center, float radius, Color color);
+
+// Draws everything added since the last clear over the top-left width x
+// height of a framebuffer targetHeight pixels tall, seen through view; call
+// outside BeginMode2D
+void LevelSdf_Draw(LevelSdf* sdf, Camera2D view, int width, int height, int targetHeight);
+
+#endif
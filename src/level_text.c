@@ -0,0 +1,143 @@
+#include "level_text.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+static char* SkipSpaces(char* p) {
+    while (*p == ' ' || *p == '\t') p++;
+    return p;
+}
+
+static int ParseFloats(char* p, float* values, int count, char** end) {
+    for (int i = 0; i < count; i++) {
+        char* next;
+        values[i] = strtof(p, &next);
+        if (next == p) return -1;
+        p = next;
+    }
+    *end = p;
+    return 0;
+}
+
+static int Fail(LevelTextError* error, int line, const char* message) {
+    if (error) {
+        error->line = line;
+        snprintf(error->message, sizeof(error->message), "%s", message);
+    }
+    return -1;
+}
+
+static int ParseLine(char* text, int line, const LevelTextSink* sink, LevelTextError* error) {
+    char* p = SkipSpaces(text);
+    if (*p == '\0' || *p == '#') return 0;
+
+    char* keyword = p;
+    while (*p && *p != ' ' && *p != '\t') p++;
+    size_t keywordLength = (size_t)(p - keyword);
+
+    float values[4];
+    const char* message = NULL;
+    if (keywordLength == 7 && strncmp(keyword, "segment", 7) == 0) {
+        if (ParseFloats(p, values, 4, &p) != 0) return Fail(error, line, "segment expects 4 numbers");
+        if (*SkipSpaces(p) != '\0') return Fail(error, line, "unexpected text after segment");
+        LineSegment segment = { { values[0], values[1] }, { values[2], values[3] } };
+        if (sink->segment && sink->segment(sink->user, segment, &message) != 0) {
+            return Fail(error, line, message ? message : "segment rejected");
+        }
+    } else if (keywordLength == 4 && strncmp(keyword, "goal", 4) == 0) {
+        if (ParseFloats(p, values, 2, &p) != 0) return Fail(error, line, "goal expects 2 numbers");
+        if (*SkipSpaces(p) != '\0') return Fail(error, line, "unexpected text after goal");
+        if (sink->goal && sink->goal(sink->user, (Vector2){ values[0], values[1] }, &message) != 0) {
+            return Fail(error, line, message ? message : "goal rejected");
+        }
+    } else {
+        if (error) {
+            error->line = line;
+            snprintf(error->message, sizeof(error->message), "unknown record '%.*s'",
+                     (int)(keywordLength > 32 ? 32 : keywordLength), keyword);
+        }
+        return -1;
+    }
+    return 0;
+}
+
+int LevelText_Parse(FILE* in, const LevelTextSink* sink, LevelTextError* error) {
+    static char buffer[LEVEL_TEXT_BUFFER_SIZE + 1];
+    size_t filled = 0;
+    int line = 0;
+    bool eof = false;
+
+    while (!eof || filled > 0) {
+        if (!eof) {
+            size_t read = fread(buffer + filled, 1, LEVEL_TEXT_BUFFER_SIZE - filled, in);
+            filled += read;
+            if (read == 0) {
+                if (ferror(in)) return Fail(error, line, "read error");
+                eof = true;
+            }
+        }
+
+        char* start = buffer;
+        char* end = buffer + filled;
+        while (start < end) {
+            char* newline = memchr(start, '\n', (size_t)(end - start));
+            if (!newline) {
+                if (!eof) break;
+                newline = end; // last line without a trailing newline
+            }
+            *newline = '\0';
+            if (newline > start && newline[-1] == '\r') newline[-1] = '\0';
+            line++;
+            if (ParseLine(start, line, sink, error) != 0) return -1;
+            start = newline + 1;
+        }
+
+        size_t rest = start < end ? (size_t)(end - start) : 0;
+        if (rest == LEVEL_TEXT_BUFFER_SIZE) return Fail(error, line + 1, "line too long");
+        memmove(buffer, start, rest);
+        filled = rest;
+        if (eof) break;
+    }
+    return 0;
+}
+
+static int AddLevelSegment(void* user, LineSegment segment, const char** message) {
+    Level* level = user;
+    if (level->segmentCount == MAX_SEGMENTS) {
+        *message = "too many segments for a level";
+        return -1;
+    }
+    level->segments[level->segmentCount++] = segment;
+    return 0;
+}
+
+static int SetLevelGoal(void* user, Vector2 goal, const char** message) {
+    (void)message;
+    ((Level*)user)->goal = goal;
+    return 0;
+}
+
+int LevelText_ReadLevel(FILE* in, Level* level, LevelTextError* error) {
+    memset(level, 0, sizeof(Level));
+    LevelTextSink sink = { AddLevelSegment, SetLevelGoal, level };
+    return LevelText_Parse(in, &sink, error);
+}
+
+// %.9g prints every float exactly, so exporting loses nothing; importing
+// through save_level or World_Write snaps segment endpoints to the 1/4 grid
+int LevelText_WriteGoal(FILE* out, Vector2 goal) {
+    return fprintf(out, "goal %.9g %.9g\n", goal.x, goal.y) < 0 ? -1 : 0;
+}
+
+int LevelText_WriteSegment(FILE* out, LineSegment segment) {
+    return fprintf(out, "segment %.9g %.9g %.9g %.9g\n",
+                   segment.start.x, segment.start.y, segment.end.x, segment.end.y) < 0 ? -1 : 0;
+}
+
+int LevelText_WriteLevel(FILE* out, const Level* level) {
+    if (LevelText_WriteGoal(out, level->goal) != 0) return -1;
+    for (int i = 0; i < level->segmentCount; i++) {
+        if (LevelText_WriteSegment(out, level->segments[i]) != 0) return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,37 @@
+#ifndef LEVEL_TEXT_H
+#define LEVEL_TEXT_H
+
+#include "level.h"
+#include <stdio.h>
+
+// Diffable text form of a level, one record per line:
+//
+//   # comment
+//   goal <x> <y>
+//   segment <x0> <y0> <x1> <y1>
+//
+// The parser streams through a fixed buffer and hands each record to the
+// sink, so it never allocates and works for inputs of any length.
+
+#define LEVEL_TEXT_BUFFER_SIZE (64 * 1024)
+
+typedef struct {
+    // Return non-zero to stop parsing with an error
+    int (*segment)(void* user, LineSegment segment, const char** message);
+    int (*goal)(void* user, Vector2 goal, const char** message);
+    void* user;
+} LevelTextSink;
+
+typedef struct {
+    int line;
+    char message[128];
+} LevelTextError;
+
+int LevelText_Parse(FILE* in, const LevelTextSink* sink, LevelTextError* error);
+int LevelText_ReadLevel(FILE* in, Level* level, LevelTextError* error);
+
+int LevelText_WriteGoal(FILE* out, Vector2 goal);
+int LevelText_WriteSegment(FILE* out, LineSegment segment);
+int LevelText_WriteLevel(FILE* out, const Level* level);
+
+#endif
@@ -1,34 +1,177 @@
+#define _POSIX_C_SOURCE 200809L // fsync, fileno, clock_gettime with -std=c99
+
 #include "raylib.h"
+#include "memory_tracker.c"
+#include "profiler.c"
+#include "profiler_overlay.c"
+#include "frame_histogram.c"
+#include "input_latency.c"
+#include "telemetry.c"
+#include "telemetry_log.c"
+#include "engine_counters.c"
+#include "geometry.c"
+#include "level.c"
+#include "segment_pack.c"
+#include "level_journal.c"
+#include "world.c"
+#include "segment_grid.c"
+#include "segment_lod.c"
+#include "level_mesh.c"
+#include "layer_cache.c"
+#include "level_sdf.c"
+#include "graph_channel.c"
+#include "hud_text.c"
+#include "dynamic_resolution.c"
 #include "screen_manager.c"
 #include "screen_gameplay.c"
 #include "screen_menu.c"
 
-int main(void) {
+#include <string.h>
+
+// Current and peak bytes per memory category
+static void ReportMemory(void) {
+    for (int i = 0; i < MEMORY_CATEGORY_COUNT; i++) {
+        TraceLog(LOG_INFO, "MEMORY: %-13s current %8.1f KiB, peak %8.1f KiB", MemoryTracker_CategoryName(i),
+                 MemoryTracker_Current(i) / 1024.0, MemoryTracker_Peak(i) / 1024.0);
+    }
+    if (TelemetryLog_IsOpen()) {
+        TraceLog(LOG_INFO, "MEMORY: telemetry log %.1f KiB mapped (file-backed, not counted above)",
+                 TelemetryLog_MappedBytes() / 1024.0);
+    }
+}
+
+int main(int argc, char** argv) {
     const int screenWidth = 800;
     const int screenHeight = 450;
     
+    // --trace FILE: F9 writes the last seconds of profiler zones there, as
+    // does exiting
+    const char* tracePath = "flywrench_trace.json";
+    bool traceOnExit = false;
+    // --frame-csv FILE: F10 writes the frame-time histogram there, as does
+    // exiting
+    const char* frameCsvPath = "flywrench_frametimes.csv";
+    bool frameCsvOnExit = false;
+    // --telemetry-log FILE: every frame is appended to a memory-mapped ring
+    // file there, see telemetry_log.h
+    const char* telemetryLogPath = NULL;
+    // --latency: measure input-to-photon latency of steering key presses
+    // and log it on exit. --vsync paces frames by vsync instead of the 60
+    // fps cap, --uncapped by neither, to compare the three
+    bool vsync = false;
+    bool uncapped = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            tracePath = argv[++i];
+            traceOnExit = true;
+        } else if (strcmp(argv[i], "--frame-csv") == 0 && i + 1 < argc) {
+            frameCsvPath = argv[++i];
+            frameCsvOnExit = true;
+        } else if (strcmp(argv[i], "--telemetry-log") == 0 && i + 1 < argc) {
+            telemetryLogPath = argv[++i];
+        } else if (strcmp(argv[i], "--latency") == 0) {
+            InputLatency_Enable(true);
+        } else if (strcmp(argv[i], "--vsync") == 0) {
+            vsync = true;
+        } else if (strcmp(argv[i], "--uncapped") == 0) {
+            uncapped = true;
+        }
+    }
+    
+    // Every frame's wall time except those spent waiting while idle
+    static FrameHistogram frameTimes;
+    FrameHistogram_Reset(&frameTimes);
+    double frameStart = 0.0;
+    bool frameIdled = true; // the first frame has no start time
+    int frameTimeChannel = Telemetry_Register("Frame Time (ms)", 0);
+    EngineCounters_Init();
+    
+    if (telemetryLogPath && TelemetryLog_Open(telemetryLogPath) != 0) {
+        TraceLog(LOG_WARNING, "TELEMETRY: Could not open log %s", telemetryLogPath);
+    }
+    
     // Initialize window
+    if (vsync && !uncapped) SetConfigFlags(FLAG_VSYNC_HINT);
     InitWindow(screenWidth, screenHeight, "Flywrench");
     
     // Set initial screen
     ChangeToScreen(SCREEN_MENU);
     
-    SetTargetFPS(60);
+    SetTargetFPS(vsync || uncapped ? 0 : 60);
     
     // Main game loop
     while (!WindowShouldClose()) {
+        double now = GetTime();
+        if (!frameIdled) {
+            FrameHistogram_Record(&frameTimes, (uint64_t)((now - frameStart) * 1e6));
+            Telemetry_Push(frameTimeChannel, (float)((now - frameStart) * 1000.0));
+        }
+        frameStart = now;
+        
+        PROFILE_FRAME_BEGIN();
+        
         // Process any pending screen changes
+        PROFILE_BEGIN("ProcessScreenChange");
         ProcessScreenChange();
+        PROFILE_END();
+        
+        // Idle screens wait here for input instead of redrawing every frame
+        PROFILE_BEGIN("Idle");
+        frameIdled = WaitWhileIdle();
+        PROFILE_END();
         
         // Update current screen
+        PROFILE_BEGIN("Update");
         Update();
+        PROFILE_END();
         
         // Draw current screen
+        PROFILE_BEGIN("Draw");
         Draw();
+        PROFILE_END();
+        
+        PROFILE_FRAME_END();
+        EngineCounters_FrameEnd();
+        
+        if (TelemetryLog_IsOpen()) {
+            TelemetryLogRecord record = {0};
+            record.frameMs = (float)((GetTime() - frameStart) * 1000.0);
+            record.screen = GetCurrentScreen();
+            record.flags = frameIdled ? TELEMETRY_LOG_IDLE : 0;
+            for (int i = 0; i < ENGINE_COUNTER_COUNT && i < TELEMETRY_LOG_COUNTERS; i++) {
+                record.counters[i] = EngineCounters_LastFrame(i);
+            }
+            TelemetryLog_Append(&record);
+        }
+        
+        if (IsKeyPressed(KEY_F9)) {
+            if (Profiler_WriteTrace(tracePath, PROFILER_TRACE_SECONDS) == 0) {
+                TraceLog(LOG_INFO, "PROFILER: Trace written to %s", tracePath);
+            }
+        }
+        if (IsKeyPressed(KEY_F10)) {
+            FrameHistogram_Report(&frameTimes, "FRAMES");
+            if (FrameHistogram_WriteCsv(&frameTimes, frameCsvPath) == 0) {
+                TraceLog(LOG_INFO, "FRAMES: Histogram written to %s", frameCsvPath);
+            }
+        }
     }
     
+    FrameHistogram_Report(&frameTimes, "FRAMES");
+    if (frameCsvOnExit && FrameHistogram_WriteCsv(&frameTimes, frameCsvPath) == 0) {
+        TraceLog(LOG_INFO, "FRAMES: Histogram written to %s", frameCsvPath);
+    }
+    
+    if (traceOnExit && Profiler_WriteTrace(tracePath, PROFILER_TRACE_SECONDS) == 0) {
+        TraceLog(LOG_INFO, "PROFILER: Trace written to %s", tracePath);
+    }
+    
+    InputLatency_Report();
+    TelemetryLog_Close();
+    
     // Clean up current screen
     Unload();
+    ReportMemory();
     
     // Close window
     CloseWindow();
@@ -0,0 +1,63 @@
+#include "memory_tracker.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Two size_t keep the block as aligned as malloc's own result
+typedef struct {
+    size_t size;
+    size_t category;
+} MemoryHeader;
+
+static long long memoryCurrent[MEMORY_CATEGORY_COUNT];
+static long long memoryPeak[MEMORY_CATEGORY_COUNT];
+
+static const char* memoryCategoryNames[MEMORY_CATEGORY_COUNT] = {
+    "Level Data",
+    "Spatial Index",
+    "Telemetry",
+    "Render Caches"
+};
+
+void MemoryTracker_Account(MemoryCategory category, long long bytes) {
+    long long current = __atomic_add_fetch(&memoryCurrent[category], bytes, __ATOMIC_RELAXED);
+    long long peak = __atomic_load_n(&memoryPeak[category], __ATOMIC_RELAXED);
+    while (current > peak &&
+           !__atomic_compare_exchange_n(&memoryPeak[category], &peak, current, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+void* MemoryTracker_Alloc(MemoryCategory category, size_t size) {
+    MemoryHeader* header = malloc(sizeof(MemoryHeader) + size);
+    if (!header) return NULL;
+    header->size = size;
+    header->category = category;
+    MemoryTracker_Account(category, (long long)size);
+    return header + 1;
+}
+
+void* MemoryTracker_Calloc(MemoryCategory category, size_t count, size_t size) {
+    if (size != 0 && count > ((size_t)-1 - sizeof(MemoryHeader)) / size) return NULL;
+    void* block = MemoryTracker_Alloc(category, count * size);
+    if (block) memset(block, 0, count * size);
+    return block;
+}
+
+void MemoryTracker_Free(void* block) {
+    if (!block) return;
+    MemoryHeader* header = (MemoryHeader*)block - 1;
+    MemoryTracker_Account((MemoryCategory)header->category, -(long long)header->size);
+    free(header);
+}
+
+long long MemoryTracker_Current(MemoryCategory category) {
+    return __atomic_load_n(&memoryCurrent[category], __ATOMIC_RELAXED);
+}
+
+long long MemoryTracker_Peak(MemoryCategory category) {
+    return __atomic_load_n(&memoryPeak[category], __ATOMIC_RELAXED);
+}
+
+const char* MemoryTracker_CategoryName(MemoryCategory category) {
+    return memoryCategoryNames[category];
+}
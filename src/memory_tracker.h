@@ -0,0 +1,38 @@
+#ifndef MEMORY_TRACKER_H
+#define MEMORY_TRACKER_H
+
+#include <stddef.h>
+
+// Current and peak bytes per subsystem. Heap blocks go through
+// MemoryTracker_Alloc/Calloc/Free, which keep the size and category in a
+// small header in front of the block; memory owned by raylib (GPU textures
+// and buffers) is added and removed with MemoryTracker_Account. File-backed
+// mappings such as the telemetry log are reclaimable page cache and are not
+// counted. Counts are atomic, so any thread may allocate.
+// Static arrays are not counted; they are fixed per build.
+
+typedef enum {
+    MEMORY_LEVEL_DATA,     // world chunk table and resident chunks
+    MEMORY_SPATIAL_INDEX,  // segment grid
+    MEMORY_TELEMETRY,      // graph histories
+    MEMORY_RENDER_CACHES,  // render targets, level mesh, LOD, SDF primitives
+    MEMORY_CATEGORY_COUNT
+} MemoryCategory;
+
+// Estimated size of a RenderTexture2D: RGBA8 color plus a 32-bit depth
+// buffer per pixel
+#define MEMORY_RENDER_TEXTURE_BYTES(width, height) ((long long)(width) * (height) * 8)
+
+void* MemoryTracker_Alloc(MemoryCategory category, size_t size);
+void* MemoryTracker_Calloc(MemoryCategory category, size_t count, size_t size);
+// Accepts NULL
+void MemoryTracker_Free(void* block);
+
+// Adds bytes (negative to remove) that were allocated elsewhere
+void MemoryTracker_Account(MemoryCategory category, long long bytes);
+
+long long MemoryTracker_Current(MemoryCategory category);
+long long MemoryTracker_Peak(MemoryCategory category);
+const char* MemoryTracker_CategoryName(MemoryCategory category);
+
+#endif
@@ -0,0 +1,147 @@
+#include "profiler.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+
+typedef struct {
+    const char* name;
+    uint64_t start;
+    uint64_t end;
+    int thread; // index into profilerThreads
+} ProfileThreadZone;
+
+typedef struct {
+    pthread_t id;
+    const char* name;
+} ProfileThread;
+
+static ProfileFrame profilerFrames[PROFILER_FRAMES];
+static int profilerCurrent;   // frame being recorded
+static int profilerCompleted; // frames recorded so far, capped at PROFILER_FRAMES - 1
+static int profilerStack[PROFILER_MAX_DEPTH];
+static int profilerDepth;
+
+static pthread_mutex_t profilerMutex = PTHREAD_MUTEX_INITIALIZER;
+static ProfileThreadZone profilerThreadZones[PROFILER_THREAD_ZONES];
+static int profilerThreadZoneHead; // next slot to write
+static int profilerThreadZoneCount;
+static ProfileThread profilerThreads[PROFILER_MAX_THREADS];
+static int profilerThreadCount;
+
+uint64_t Profiler_Now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+void Profiler_FrameBegin(void) {
+    ProfileFrame* frame = &profilerFrames[profilerCurrent];
+    frame->start = Profiler_Now();
+    frame->end = frame->start;
+    frame->zoneCount = 0;
+    profilerDepth = 0;
+}
+
+void Profiler_FrameEnd(void) {
+    ProfileFrame* frame = &profilerFrames[profilerCurrent];
+    frame->end = Profiler_Now();
+    profilerCurrent = (profilerCurrent + 1) % PROFILER_FRAMES;
+    if (profilerCompleted < PROFILER_FRAMES - 1) profilerCompleted++;
+}
+
+void Profiler_Begin(const char* name) {
+    ProfileFrame* frame = &profilerFrames[profilerCurrent];
+    int index = -1;
+    if (frame->zoneCount < PROFILER_MAX_ZONES && profilerDepth < PROFILER_MAX_DEPTH) {
+        index = frame->zoneCount++;
+        frame->zones[index] = (ProfileZone){ name, Profiler_Now(), 0, profilerDepth };
+    }
+    if (profilerDepth < PROFILER_MAX_DEPTH) profilerStack[profilerDepth] = index;
+    profilerDepth++;
+}
+
+void Profiler_End(void) {
+    if (profilerDepth == 0) return;
+    profilerDepth--;
+    if (profilerDepth >= PROFILER_MAX_DEPTH) return;
+    int index = profilerStack[profilerDepth];
+    if (index >= 0) profilerFrames[profilerCurrent].zones[index].end = Profiler_Now();
+}
+
+const ProfileFrame* Profiler_GetFrame(int age) {
+    if (age < 0 || age >= profilerCompleted) return NULL;
+    return &profilerFrames[(profilerCurrent - 1 - age + PROFILER_FRAMES) % PROFILER_FRAMES];
+}
+
+void Profiler_RegisterThread(const char* name) {
+    pthread_mutex_lock(&profilerMutex);
+    for (int i = 0; i < profilerThreadCount; i++) {
+        if (pthread_equal(profilerThreads[i].id, pthread_self())) {
+            profilerThreads[i].name = name;
+            pthread_mutex_unlock(&profilerMutex);
+            return;
+        }
+    }
+    if (profilerThreadCount < PROFILER_MAX_THREADS) {
+        profilerThreads[profilerThreadCount++] = (ProfileThread){ pthread_self(), name };
+    }
+    pthread_mutex_unlock(&profilerMutex);
+}
+
+void Profiler_RecordThreadZone(const char* name, uint64_t start) {
+    uint64_t end = Profiler_Now();
+    pthread_mutex_lock(&profilerMutex);
+    int thread = -1;
+    for (int i = 0; i < profilerThreadCount; i++) {
+        if (pthread_equal(profilerThreads[i].id, pthread_self())) thread = i;
+    }
+    profilerThreadZones[profilerThreadZoneHead] = (ProfileThreadZone){ name, start, end, thread };
+    profilerThreadZoneHead = (profilerThreadZoneHead + 1) % PROFILER_THREAD_ZONES;
+    if (profilerThreadZoneCount < PROFILER_THREAD_ZONES) profilerThreadZoneCount++;
+    pthread_mutex_unlock(&profilerMutex);
+}
+
+// Chrome trace tids: 1 is the main thread, registered workers follow from
+// 2, 0 is any unregistered thread; ts and dur are microseconds from origin
+static void WriteTraceEvent(FILE* file, const char* name, uint64_t start, uint64_t end, uint64_t origin, int tid) {
+    fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+            name, tid, (double)(int64_t)(start - origin) / 1000.0, (end - start) / 1000.0);
+}
+
+int Profiler_WriteTrace(const char* filename, double seconds) {
+    FILE* file = fopen(filename, "w");
+    if (!file) return -1;
+    uint64_t now = Profiler_Now();
+    uint64_t window = (uint64_t)(seconds * 1e9);
+    uint64_t from = now > window ? now - window : 0;
+
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    fprintf(file, "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"main\"}}");
+
+    for (int age = profilerCompleted - 1; age >= 0; age--) {
+        const ProfileFrame* frame = Profiler_GetFrame(age);
+        if (frame->end < from) continue;
+        WriteTraceEvent(file, "Frame", frame->start, frame->end, from, 1);
+        for (int i = 0; i < frame->zoneCount; i++) {
+            const ProfileZone* zone = &frame->zones[i];
+            if (zone->end < zone->start) continue;
+            WriteTraceEvent(file, zone->name, zone->start, zone->end, from, 1);
+        }
+    }
+
+    pthread_mutex_lock(&profilerMutex);
+    for (int i = 0; i < profilerThreadCount; i++) {
+        fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                i + 2, profilerThreads[i].name);
+    }
+    for (int k = 0; k < profilerThreadZoneCount; k++) {
+        int index = (profilerThreadZoneHead - profilerThreadZoneCount + k + PROFILER_THREAD_ZONES) % PROFILER_THREAD_ZONES;
+        const ProfileThreadZone* zone = &profilerThreadZones[index];
+        if (zone->end < from) continue;
+        WriteTraceEvent(file, zone->name, zone->start, zone->end, from, zone->thread >= 0 ? zone->thread + 2 : 0);
+    }
+    pthread_mutex_unlock(&profilerMutex);
+
+    fprintf(file, "\n]}\n");
+    return fclose(file) == 0 ? 0 : -1;
+}
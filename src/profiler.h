@@ -0,0 +1,76 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+
+// Scoped-zone frame profiler. PROFILE_BEGIN/PROFILE_END pairs nest and are
+// timed with CLOCK_MONOTONIC; each frame's zones go into a ring of the last
+// PROFILER_FRAMES frames. Zones past PROFILER_MAX_ZONES in a frame are
+// dropped. These are main thread only; worker threads name themselves with
+// PROFILE_THREAD_NAME and record flat zones with PROFILE_THREAD_ZONE into a
+// shared, mutex-protected ring. Nothing is serialized until
+// Profiler_WriteTrace. Define NO_PROFILER to compile the macros out.
+
+#define PROFILER_FRAMES 600
+#define PROFILER_MAX_ZONES 32
+#define PROFILER_MAX_DEPTH 8
+#define PROFILER_THREAD_ZONES 4096
+#define PROFILER_MAX_THREADS 8
+#define PROFILER_TRACE_SECONDS 10.0
+
+#ifdef NO_PROFILER
+#define PROFILE_FRAME_BEGIN() ((void)0)
+#define PROFILE_FRAME_END() ((void)0)
+#define PROFILE_BEGIN(name) ((void)0)
+#define PROFILE_END() ((void)0)
+#define PROFILE_NOW() ((uint64_t)0)
+#define PROFILE_THREAD_NAME(name) ((void)0)
+#define PROFILE_THREAD_ZONE(name, start) ((void)(start))
+#else
+#define PROFILE_FRAME_BEGIN() Profiler_FrameBegin()
+#define PROFILE_FRAME_END() Profiler_FrameEnd()
+#define PROFILE_BEGIN(name) Profiler_Begin(name)
+#define PROFILE_END() Profiler_End()
+#define PROFILE_NOW() Profiler_Now()
+#define PROFILE_THREAD_NAME(name) Profiler_RegisterThread(name)
+#define PROFILE_THREAD_ZONE(name, start) Profiler_RecordThreadZone(name, start)
+#endif
+
+typedef struct {
+    const char* name; // string literal; compared by pointer
+    uint64_t start;   // nanoseconds
+    uint64_t end;
+    int depth;
+} ProfileZone;
+
+typedef struct {
+    uint64_t start;
+    uint64_t end;
+    int zoneCount;
+    ProfileZone zones[PROFILER_MAX_ZONES];
+} ProfileFrame;
+
+uint64_t Profiler_Now(void);
+
+void Profiler_FrameBegin(void);
+void Profiler_FrameEnd(void);
+void Profiler_Begin(const char* name);
+void Profiler_End(void);
+
+// Worker threads: name the calling thread once, then record zones that ran
+// from start until now
+void Profiler_RegisterThread(const char* name);
+void Profiler_RecordThreadZone(const char* name, uint64_t start);
+
+// Completed frame, 0 being the most recent; NULL past the recorded history
+const ProfileFrame* Profiler_GetFrame(int age);
+
+// Writes the last seconds of frames and thread zones as Chrome trace-event
+// JSON (chrome://tracing, Perfetto); returns 0 on success, -1 on failure
+int Profiler_WriteTrace(const char* filename, double seconds);
+
+// Stacked per-frame bars of the top-level zones over recent frames, and the
+// most recent frame's zones laid out by time and depth (profiler_overlay.c)
+void Profiler_DrawTimeline(int x, int y, int width, int height);
+
+#endif
@@ -0,0 +1,65 @@
+#include "profiler.h"
+#include "raylib.h"
+
+#define PROFILER_TIMELINE_FRAMES 120
+#define PROFILER_TIMELINE_MS 33.3f // full height of the frame bars
+
+static Color ZoneColor(const char* name) {
+    static const Color palette[] = { SKYBLUE, ORANGE, LIME, PINK, GOLD, VIOLET, BEIGE, MAROON };
+    uintptr_t hash = (uintptr_t)name;
+    hash ^= hash >> 7;
+    return palette[(hash >> 3) % (sizeof(palette) / sizeof(palette[0]))];
+}
+
+static float ZoneMs(const ProfileZone* zone) {
+    return zone->end > zone->start ? (zone->end - zone->start) / 1e6f : 0.0f;
+}
+
+void Profiler_DrawTimeline(int x, int y, int width, int height) {
+    DrawRectangle(x, y, width, height, (Color){40, 40, 40, 200});
+    DrawRectangleLines(x, y, width, height, WHITE);
+
+    const ProfileFrame* last = Profiler_GetFrame(0);
+    if (!last) return;
+
+    // Recent frames, newest on the right, top-level zones stacked
+    int barsHeight = height / 2;
+    float barWidth = (float)width / PROFILER_TIMELINE_FRAMES;
+    float msScale = barsHeight / PROFILER_TIMELINE_MS;
+    int budgetY = y + barsHeight - (int)(16.6f * msScale);
+    for (int age = 0; age < PROFILER_TIMELINE_FRAMES; age++) {
+        const ProfileFrame* frame = Profiler_GetFrame(age);
+        if (!frame) break;
+        float barX = x + width - (age + 1) * barWidth;
+        float stacked = 0.0f;
+        for (int i = 0; i < frame->zoneCount; i++) {
+            const ProfileZone* zone = &frame->zones[i];
+            if (zone->depth != 0) continue;
+            float h = ZoneMs(zone) * msScale;
+            if (stacked + h > barsHeight) h = barsHeight - stacked;
+            if (h <= 0) continue;
+            DrawRectangleRec((Rectangle){ barX, y + barsHeight - stacked - h, barWidth, h }, ZoneColor(zone->name));
+            stacked += h;
+        }
+    }
+    DrawLine(x, budgetY, x + width, budgetY, RED);
+    DrawText(TextFormat("frame %.2f ms", (last->end - last->start) / 1e6f), x + 5, y + 5, 10, WHITE);
+
+    // Latest frame laid out in time, one row per depth
+    int rowY = y + barsHeight + 4;
+    int rowHeight = 14;
+    float span = (float)(last->end - last->start);
+    if (span <= 0) return;
+    for (int i = 0; i < last->zoneCount; i++) {
+        const ProfileZone* zone = &last->zones[i];
+        if (zone->end < zone->start) continue;
+        float zx = x + width * ((zone->start - last->start) / span);
+        float zw = width * ((zone->end - zone->start) / span);
+        if (zw < 1) zw = 1;
+        Rectangle bar = { zx, rowY + zone->depth * rowHeight, zw, rowHeight - 2 };
+        if (bar.y + bar.height > y + height) continue;
+        DrawRectangleRec(bar, ZoneColor(zone->name));
+        const char* label = TextFormat("%s %.2f", zone->name, ZoneMs(zone));
+        if (MeasureText(label, 10) + 4 < zw) DrawText(label, bar.x + 2, bar.y + 1, 10, BLACK);
+    }
+}
@@ -1,5 +1,22 @@
 #include "screen_gameplay.h"
 #include "screen_manager.h"
+#include "level.h"
+#include "level_journal.h"
+#include "world.h"
+#include "segment_grid.h"
+#include "segment_lod.h"
+#include "level_mesh.h"
+#include "layer_cache.h"
+#include "level_sdf.h"
+#include "graph_channel.h"
+#include "telemetry.h"
+#include "engine_counters.h"
+#include "geometry.h"
+#include "input_latency.h"
+#include "memory_tracker.h"
+#include "hud_text.h"
+#include "dynamic_resolution.h"
+#include "profiler.h"
 #include "raylib.h"
 #include "raymath.h"
 #include <stdbool.h>
@@ -9,23 +26,22 @@
 #define WING_WIDTH 40
 #define WING_THICKNESS 4.0f
 #define SEGMENT_THICKNESS 10.0f
-#define MAX_SEGMENTS 100
 #define ROT_SPEED 300.0
 #define GRAPH_WIDTH 300
 #define GRAPH_HEIGHT 120
-#define GRAPH_SAMPLES 150
+#define GRAPH_MIN_HEIGHT 45
 #define GRAPH_DISPLAY_SAMPLES 50
-
-typedef struct {
-    Vector2 start;
-    Vector2 end;
-} LineSegment;
-
-typedef struct {
-    LineSegment segments[MAX_SEGMENTS];
-    int segmentCount;
-    Vector2 goal;
-} Level;
+#define GRAPH_SAMPLE_INTERVAL 0.05f
+#define PROFILER_OVERLAY_WIDTH 360
+#define PROFILER_OVERLAY_HEIGHT 160
+#define SEGMENT_QUERY_MAX 4096
+// What DrawLineEx (two triangles) and DrawCircleV (36 segments as quads) add
+// to the rlgl batch
+#define DRAW_LINE_VERTICES 6
+#define DRAW_CIRCLE_VERTICES 72
+#define SIM_TICK_RATE 60
+#define SIM_TICK (1.0f / SIM_TICK_RATE)
+#define SIM_MAX_FRAME_TIME 0.25f // longer frames drop time instead of piling up ticks
 
 enum EditMode {
     EDIT_LINES_ADD,
@@ -33,6 +49,43 @@ enum EditMode {
     EDIT_GOAL_PLACE
 };
 
+// How level segments are drawn; streamed worlds draw LEVEL_RENDER_MESH, and
+// LEVEL_RENDER_SDF views with too many segments, as LEVEL_RENDER_IMMEDIATE
+enum LevelRenderMode {
+    LEVEL_RENDER_IMMEDIATE, // DrawLineEx per visible segment
+    LEVEL_RENDER_MESH,      // static vertex buffer, one draw call
+    LEVEL_RENDER_CACHED,    // segments and goal cached in a render texture
+    LEVEL_RENDER_SDF,       // player, segments and goal in one shader pass
+    LEVEL_RENDER_MODE_COUNT
+};
+
+// HudText slots; each graph takes three (label, max, min)
+enum HudSlot {
+    HUD_FLAP_VELOCITY,
+    HUD_FLAP_AMOUNT,
+    HUD_PLAYER_VELOCITY,
+    HUD_PLAYER_ROTATION,
+    HUD_CURRENT_LEVEL,
+    HUD_EDIT_MODE,
+    HUD_RENDER_MODE,
+    HUD_RESOLUTION,
+    HUD_MODE_HINT,
+    HUD_SAVE_HINT,
+    HUD_COUNTER_FIRST, // one per engine counter
+    HUD_MEMORY_FIRST = HUD_COUNTER_FIRST + ENGINE_COUNTER_COUNT, // one per memory category
+    HUD_TELEMETRY_LOG = HUD_MEMORY_FIRST + MEMORY_CATEGORY_COUNT,
+    HUD_GRAPH_FIRST // one triple per telemetry channel
+};
+
+// The state drawn between two simulation ticks, blended by the fraction of
+// a tick left in the accumulator
+typedef struct {
+    Vector2 playerPos;
+    float playerRot;
+    float flapAmount;
+    Vector2 cameraTarget;
+} SimState;
+
 // Static variables for gameplay state
 static Vector2 playerPos;
 static float playerRot;
@@ -52,11 +105,29 @@ static Vector2 editModeStartPosition;
 static enum EditMode editModeCurrent;
 static bool graphEnabled;
 static bool debugInfoEnabled;
-static float flapVelocityHistory[GRAPH_SAMPLES];
-static float flapAmountHistory[GRAPH_SAMPLES];
-static float playerVelocityMagnitudeHistory[GRAPH_SAMPLES];
-static int graphIndex;
-static float graphUpdateTimer;
+static bool profilerOverlayEnabled;
+static int flapVelocityChannel;
+static int flapAmountChannel;
+static int playerSpeedChannel;
+// Graph history per registered telemetry channel, fed from its ring
+static GraphChannel telemetryGraphs[TELEMETRY_MAX_CHANNELS];
+static uint32_t telemetryCursors[TELEMETRY_MAX_CHANNELS];
+static int telemetryGraphCount;
+static HudText hudText;
+static DynamicResolution dynamicResolution;
+static bool dynamicResolutionEnabled;
+static const LineSegment* querySegments[SEGMENT_QUERY_MAX];
+static int queryIndices[MAX_SEGMENTS];
+static SegmentGrid levelGrid;
+static SegmentLod levelLod;
+static LevelMesh levelMesh;
+static enum LevelRenderMode levelRenderMode;
+static LayerCache levelCache;
+static LevelSdf levelSdf;
+static unsigned int levelRevision; // bumped on every segment or goal change
+static float simAccumulator;
+static SimState simPrevious;
+static bool simTeleported; // skip blending across the next tick
 
 const char* EditModeToString(enum EditMode mode) {
     switch(mode) {
@@ -67,83 +138,233 @@ const char* EditModeToString(enum EditMode mode) {
     }
 }
 
-void save_level(Level* level, const char* filename) {
-    FILE* file = fopen(filename, "wb");
-    if (!file) return;
-    fwrite(level, sizeof(Level), 1, file);
-    fclose(file);
+const char* LevelRenderModeToString(enum LevelRenderMode mode) {
+    switch(mode) {
+        case LEVEL_RENDER_IMMEDIATE: return "IMMEDIATE";
+        case LEVEL_RENDER_MESH: return "MESH";
+        case LEVEL_RENDER_CACHED: return "CACHED";
+        case LEVEL_RENDER_SDF: return "SDF";
+        default: return "UNKNOWN";
+    }
+}
+
+static SimState CaptureSimState(void) {
+    return (SimState){ playerPos, playerRot, flapAmount, camera.target };
+}
+
+static SimState InterpolateSimState(float alpha) {
+    SimState current = CaptureSimState();
+    return (SimState){
+        Vector2Lerp(simPrevious.playerPos, current.playerPos, alpha),
+        Lerp(simPrevious.playerRot, current.playerRot, alpha),
+        Lerp(simPrevious.flapAmount, current.flapAmount, alpha),
+        Vector2Lerp(simPrevious.cameraTarget, current.cameraTarget, alpha)
+    };
+}
+
+static void GetWingPositions(Vector2 pos, float rot, float flap, Vector2* left, Vector2* right) {
+    *left = Vector2Rotate((Vector2){-WING_WIDTH, 0}, rot * DEG2RAD);
+    *right = Vector2Rotate((Vector2){WING_WIDTH, 0}, rot * DEG2RAD);
+    *left = Vector2Add(Vector2Rotate(*left, -flap * DEG2RAD), pos);
+    *right = Vector2Add(Vector2Rotate(*right, flap * DEG2RAD), pos);
+}
+
+static void ResetPlayer(Vector2 pos) {
+    playerRot = 0.0;
+    playerPos = pos;
+    playerVelocity = (Vector2){0, 0};
+    simTeleported = true;
+}
+
+// Updates everything derived from currentLevelData.segments after the
+// segment at changedIndex was written, or after a reload when it is -1
+static void LevelSegmentsChanged(int changedIndex) {
+    levelRevision++;
+    SegmentGrid_Build(&levelGrid, currentLevelData.segments, currentLevelData.segmentCount);
+    SegmentLod_Build(&levelLod, currentLevelData.segments, currentLevelData.segmentCount);
+    if (changedIndex < 0) {
+        LevelMesh_SetSegments(&levelMesh, currentLevelData.segments, currentLevelData.segmentCount);
+    } else {
+        if (changedIndex < currentLevelData.segmentCount) {
+            LevelMesh_SetSegment(&levelMesh, changedIndex, currentLevelData.segments[changedIndex]);
+        }
+        LevelMesh_SetCount(&levelMesh, currentLevelData.segmentCount);
+    }
 }
 
-int load_level(Level* level, const char* filename) {
-    FILE* file = fopen(filename, "rb");
-    if (!file) {
-        memset(level, 0, sizeof(Level));
-        return 0;
+// Loads "levelN.world" as a streamed world if present, else "levelN"
+static void LoadLevel(int index) {
+    PROFILE_BEGIN("LoadLevel");
+    if (World_Open(TextFormat("level%d.world", index))) {
+        memset(&currentLevelData, 0, sizeof(Level));
+        currentLevelData.goal = World_Goal();
+        World_Prefetch((Vector2){100, 100}); // player spawn
+    } else {
+        LevelJournal_Open(&currentLevelData, TextFormat("level%d", index));
     }
-    fread(level, sizeof(Level), 1, file);
-    fclose(file);
-    return 0;
+    LevelSegmentsChanged(-1);
+    PROFILE_END();
 }
 
-int orientation(Vector2 a, Vector2 b, Vector2 c) {
-    float val = (b.y - a.y) * (c.x - b.x) - (b.x - a.x) * (c.y - b.y);
-    if (val == 0.0) return 0;
-    if (val > 0) return 1;
-    return 2;
+// Segments of the current level near area; streamed worlds only search the
+// resident chunks
+static int QueryLevelSegments(Rectangle area, const LineSegment** out, int maxOut) {
+    int count;
+    if (World_IsOpen()) {
+        count = World_Query(area, out, maxOut);
+    } else {
+        count = SegmentGrid_Query(&levelGrid, area, queryIndices, maxOut < MAX_SEGMENTS ? maxOut : MAX_SEGMENTS);
+        for (int i = 0; i < count; i++) {
+            out[i] = &currentLevelData.segments[queryIndices[i]];
+        }
+    }
+    ENGINE_COUNT(COUNTER_BROADPHASE_SEGMENTS, count);
+    return count;
 }
 
-bool intersects(Vector2 p1, Vector2 p2, Vector2 q1, Vector2 q2) {
-    int o1 = orientation(p1, p2, q1);
-    int o2 = orientation(p1, p2, q2);
-    int o3 = orientation(q1, q2, p1);
-    int o4 = orientation(q1, q2, p2);
-    return (o1 != o2) && (o3 != o4);
+// DrawLineEx and DrawCircleV, counted
+static void DrawLineCounted(Vector2 start, Vector2 end, float thickness, Color color) {
+    ENGINE_COUNT(COUNTER_DRAW_LINES, 1);
+    ENGINE_COUNT(COUNTER_BATCH_VERTICES, DRAW_LINE_VERTICES);
+    DrawLineEx(start, end, thickness, color);
 }
 
-bool CollisionWithLine(Vector2 playerPos, Vector2 leftWing, Vector2 rightWing, Vector2 p1, Vector2 p2) {
-    if (intersects(playerPos, leftWing, p1, p2)) return true;
-    if (intersects(playerPos, rightWing, p1, p2)) return true;
-    Vector2 offPlayerPos = {playerPos.x + 10, playerPos.y + 10};
-    if (intersects(offPlayerPos, leftWing, p1, p2)) return true;
-    if (intersects(offPlayerPos, rightWing, p1, p2)) return true;
-    return false;
+static void DrawCircleCounted(Vector2 center, float radius, Color color) {
+    ENGINE_COUNT(COUNTER_DRAW_CIRCLES, 1);
+    ENGINE_COUNT(COUNTER_BATCH_VERTICES, DRAW_CIRCLE_VERTICES);
+    DrawCircleV(center, radius, color);
 }
 
-void DrawGraph(float* data, int samples, int startIndex, float x, float y, float width, float height, Color color, const char* label) {
-    int displaySamples = GRAPH_DISPLAY_SAMPLES;
-    int displayStartIndex = (startIndex - displaySamples + samples) % samples;
-    
-    float minVal = data[displayStartIndex];
-    float maxVal = data[displayStartIndex];
-    for (int i = 0; i < displaySamples; i++) {
-        int idx = (displayStartIndex + i) % samples;
-        if (data[idx] < minVal) minVal = data[idx];
-        if (data[idx] > maxVal) maxVal = data[idx];
+// World-space bounds of a width x height viewport seen through view,
+// rotation included
+static Rectangle GetCameraViewRect(Camera2D view, float width, float height) {
+    Vector2 corners[4] = {
+        GetScreenToWorld2D((Vector2){0, 0}, view),
+        GetScreenToWorld2D((Vector2){width, 0}, view),
+        GetScreenToWorld2D((Vector2){0, height}, view),
+        GetScreenToWorld2D((Vector2){width, height}, view)
+    };
+    Vector2 min = corners[0];
+    Vector2 max = corners[0];
+    for (int i = 1; i < 4; i++) {
+        min = Vector2Min(min, corners[i]);
+        max = Vector2Max(max, corners[i]);
     }
+    return (Rectangle){min.x, min.y, max.x - min.x, max.y - min.y};
+}
+
+// World area a segment must overlap to show in a width x height viewport
+static Rectangle GetSegmentDrawArea(Camera2D view, float width, float height) {
+    Rectangle drawArea = GetCameraViewRect(view, width, height);
+    drawArea.x -= SEGMENT_THICKNESS;
+    drawArea.y -= SEGMENT_THICKNESS;
+    drawArea.width += 2 * SEGMENT_THICKNESS;
+    drawArea.height += 2 * SEGMENT_THICKNESS;
+    return drawArea;
+}
+
+// Segments that can touch a width x height viewport seen through view
+static int QueryVisibleSegments(Camera2D view, float width, float height) {
+    return QueryLevelSegments(GetSegmentDrawArea(view, width, height), querySegments, SEGMENT_QUERY_MAX);
+}
+
+// Segments visible in a width x height viewport, one DrawLineEx each; call
+// inside BeginMode2D(view). Zoomed out in the editor, a simplified LOD level
+// is drawn instead (streamed worlds have none)
+static void DrawLevelSegments(Camera2D view, float width, float height) {
+    int lodLevel = editMode && !World_IsOpen() ? SegmentLod_LevelForZoom(view.zoom) : 0;
+    if (lodLevel > 0) {
+        Rectangle area = GetSegmentDrawArea(view, width, height);
+        for (int i = 0; i < levelLod.counts[lodLevel]; i++) {
+            LineSegment s = levelLod.segments[lodLevel][i];
+            if (fmaxf(s.start.x, s.end.x) < area.x || fminf(s.start.x, s.end.x) > area.x + area.width ||
+                fmaxf(s.start.y, s.end.y) < area.y || fminf(s.start.y, s.end.y) > area.y + area.height) {
+                continue;
+            }
+            DrawLineCounted(s.start, s.end, SEGMENT_THICKNESS, RAYWHITE);
+        }
+        return;
+    }
+    int drawCount = QueryVisibleSegments(view, width, height);
+    for (int i = 0; i < drawCount; i++) {
+        DrawLineCounted(querySegments[i]->start, querySegments[i]->end, SEGMENT_THICKNESS, RAYWHITE);
+    }
+}
+
+static void DrawGoal(void) {
+    if (currentLevelData.goal.x != 0 || currentLevelData.goal.y != 0) {
+        DrawCircleCounted(currentLevelData.goal, 30, GREEN);
+        DrawCircleCounted(currentLevelData.goal, 25, DARKGREEN);
+    }
+}
+
+static void DrawPlayer(Vector2 pos, Vector2 left, Vector2 right) {
+    DrawLineCounted(left, pos, WING_THICKNESS, WHITE);
+    DrawLineCounted(pos, right, WING_THICKNESS, WHITE);
     
-    float range = maxVal - minVal;
-    if (range < 0.1f) range = 0.1f;
-    minVal -= range * 0.1f;
-    maxVal += range * 0.1f;
-    range = maxVal - minVal;
+    DrawCircleCounted(clickCircle, 20, RED);
+}
+
+// DrawPlayer, DrawLevelSegments and DrawGoal as one shader pass into the
+// top-left width x height of the framebuffer; call outside BeginMode2D.
+// Draws nothing and returns false if the visible segments would not fit in
+// the primitive texture, e.g. in a dense streamed world
+static bool DrawSceneSdf(Camera2D view, Vector2 pos, Vector2 left, Vector2 right, int width, int height) {
+    int drawCount = QueryVisibleSegments(view, width, height);
+    if (drawCount > LEVEL_SDF_MAX_PRIMITIVES - 5) return false; // wings, click and goal circles
+    LevelSdf_Clear(&levelSdf);
+    LevelSdf_AddLine(&levelSdf, left, pos, WING_THICKNESS, WHITE);
+    LevelSdf_AddLine(&levelSdf, pos, right, WING_THICKNESS, WHITE);
+    LevelSdf_AddCircle(&levelSdf, clickCircle, 20, RED);
+    for (int i = 0; i < drawCount; i++) {
+        LevelSdf_AddLine(&levelSdf, querySegments[i]->start, querySegments[i]->end, SEGMENT_THICKNESS, RAYWHITE);
+    }
+    if (currentLevelData.goal.x != 0 || currentLevelData.goal.y != 0) {
+        LevelSdf_AddCircle(&levelSdf, currentLevelData.goal, 30, GREEN);
+        LevelSdf_AddCircle(&levelSdf, currentLevelData.goal, 25, DARKGREEN);
+    }
+    LevelSdf_Draw(&levelSdf, view, width, height, GetScreenHeight());
+    return true;
+}
+
+// One polyline per graph; min, max and their labels come precomputed from
+// the channel and go to hudText slots hudSlot..hudSlot + 2
+void DrawGraph(const GraphChannel* channel, float x, float y, float width, float height, Color color, const char* label, int hudSlot) {
+    static float heights[GRAPH_CHANNEL_MAX_POINTS];
+    static Vector2 points[GRAPH_CHANNEL_MAX_POINTS];
     
+    PROFILE_BEGIN("DrawGraph");
     DrawRectangle(x, y, width, height, (Color){40, 40, 40, 200});
     DrawRectangleLines(x, y, width, height, WHITE);
     
-    DrawText(label, x + 5, y + 5, 12, WHITE);
-    DrawText(TextFormat("%.2f", maxVal), x + 5, y + 20, 10, LIGHTGRAY);
-    DrawText(TextFormat("%.2f", minVal), x + 5, y + height - 15, 10, LIGHTGRAY);
+    HudText_Printf(&hudText, hudSlot, x + 5, y + 5, 12, WHITE, 0, "%s", label);
+    HudText_Printf(&hudText, hudSlot + 1, x + 5, y + 20, 10, LIGHTGRAY, HUD_TEXT_THROTTLE, "%s", channel->maxLabel);
+    HudText_Printf(&hudText, hudSlot + 2, x + 5, y + height - 15, 10, LIGHTGRAY, HUD_TEXT_THROTTLE, "%s", channel->minLabel);
     
-    for (int i = 1; i < displaySamples; i++) {
-        int prevIndex = (displayStartIndex + i - 1) % samples;
-        int currIndex = (displayStartIndex + i) % samples;
-        
-        float x1 = x + ((float)(i - 1) / (displaySamples - 1)) * width;
-        float y1 = y + height - ((data[prevIndex] - minVal) / range) * height;
-        float x2 = x + ((float)i / (displaySamples - 1)) * width;
-        float y2 = y + height - ((data[currIndex] - minVal) / range) * height;
-        
-        DrawLineEx((Vector2){x1, y1}, (Vector2){x2, y2}, 2.0f, color);
+    int count = GraphChannel_Points(channel, heights);
+    for (int i = 0; i < count; i++) {
+        points[i].x = x + ((float)i / (count - 1)) * width;
+        points[i].y = y + height - heights[i] * height;
+    }
+    if (count >= 2) DrawSplineLinear(points, count, 2.0f, color);
+    PROFILE_END();
+}
+
+// Picks up channels registered since the last call and moves new samples
+// from every channel's ring into its graph
+static void SyncTelemetryGraphs(void) {
+    static float samples[TELEMETRY_RING_SIZE];
+    int channelCount = Telemetry_ChannelCount();
+    while (telemetryGraphCount < channelCount) {
+        GraphChannel_Init(&telemetryGraphs[telemetryGraphCount], GRAPH_DISPLAY_SAMPLES);
+        telemetryCursors[telemetryGraphCount] = 0;
+        telemetryGraphCount++;
+    }
+    for (int i = 0; i < telemetryGraphCount; i++) {
+        int count = Telemetry_Read(i, &telemetryCursors[i], samples, GRAPH_DISPLAY_SAMPLES);
+        for (int j = 0; j < count; j++) {
+            GraphChannel_Push(&telemetryGraphs[i], samples[j]);
+        }
     }
 }
 
@@ -171,18 +392,104 @@ void ScreenGameplay_Init(void) {
     
     graphEnabled = false;
     debugInfoEnabled = 0;
+    profilerOverlayEnabled = false;
 
-    memset(flapVelocityHistory, 0, sizeof(flapVelocityHistory));
-    memset(flapAmountHistory, 0, sizeof(flapAmountHistory));
-    memset(playerVelocityMagnitudeHistory, 0, sizeof(playerVelocityMagnitudeHistory));
-    graphIndex = 0;
-    graphUpdateTimer = 0.0f;
+    flapVelocityChannel = Telemetry_Register("Flap Velocity", GRAPH_SAMPLE_INTERVAL);
+    flapAmountChannel = Telemetry_Register("Flap Amount", GRAPH_SAMPLE_INTERVAL);
+    playerSpeedChannel = Telemetry_Register("Player Speed", GRAPH_SAMPLE_INTERVAL);
+    telemetryGraphCount = 0;
+    
+    simAccumulator = 0.0f;
+    simPrevious = CaptureSimState();
+    InputLatency_Cancel();
+    simTeleported = false;
     
-    load_level(&currentLevelData, TextFormat("level%d", currentLevel));
+    levelRenderMode = LEVEL_RENDER_MESH;
+    dynamicResolutionEnabled = false;
+    LevelMesh_Load(&levelMesh, MAX_SEGMENTS, SEGMENT_THICKNESS, RAYWHITE);
+    LevelSdf_Load(&levelSdf);
+    
+    LevelJournal_Start();
+    LoadLevel(currentLevel);
+}
+
+// Advances play mode by one fixed step of delta seconds
+static void SimulateTick(float delta) {
+    if (IsKeyDown(KEY_RIGHT)) {
+        playerRot += ROT_SPEED * delta;
+    }
+    
+    if (IsKeyDown(KEY_LEFT)) {
+        playerRot -= ROT_SPEED * delta;
+    }
+    
+    if (IsKeyDown(KEY_DOWN)) {
+        if (flapAmount < 90.0) {
+            flapVelocity += 30.0 * delta + flapVelocity;
+        }
+        if (flapVelocity > 2000.0) flapVelocity = 2000.0;
+        flapAmount += flapVelocity;
+        if (flapAmount >= 90.0) {
+            flapAmount = 90.0;
+            flapVelocity = 0;
+        }
+    } else {
+        flapVelocity = 0;
+        flapAmount -= 500.0 * delta;
+        if (flapAmount < 0.0) flapAmount = 0.0;
+    }
+    
+    Vector2 velocityFromFlapVector = Vector2Rotate((Vector2){0, -flapVelocity * 8 * delta}, DEG2RAD * playerRot);
+    playerVelocity = Vector2Add(velocityFromFlapVector, playerVelocity);
+    
+    // gravity
+    playerVelocity = Vector2Add(playerVelocity, (Vector2){0, 10 * delta});
+    
+    playerPos = Vector2Add(playerPos, playerVelocity);
+    
+    // Camera follows player with smooth movement
+    float distance = Vector2Distance(playerPos, camera.target);
+    if (distance > 100.0) {
+        Vector2 difference = Vector2Subtract(playerPos, camera.target);
+        Vector2 direction = Vector2Normalize(difference);
+        Vector2 targetPos = Vector2Add(camera.target, Vector2Scale(direction, distance - 100.0));
+        camera.target = targetPos;
+    }
+    
+    GetWingPositions(playerPos, playerRot, flapAmount, &leftWing, &rightWing);
+    
+    // Collision detection
+    Rectangle playerArea = {
+        fminf(playerPos.x, fminf(leftWing.x, rightWing.x)),
+        fminf(playerPos.y, fminf(leftWing.y, rightWing.y)),
+        0, 0
+    };
+    playerArea.width = fmaxf(playerPos.x + 10, fmaxf(leftWing.x, rightWing.x)) - playerArea.x;
+    playerArea.height = fmaxf(playerPos.y + 10, fmaxf(leftWing.y, rightWing.y)) - playerArea.y;
+    PROFILE_BEGIN("Collision");
+    int nearCount = QueryLevelSegments(playerArea, querySegments, SEGMENT_QUERY_MAX);
+    for (int i = 0; i < nearCount; i++) {
+        if (CollisionWithLine(playerPos, leftWing, rightWing,
+                            querySegments[i]->start, querySegments[i]->end)) {
+            ResetPlayer((Vector2){100, 50});
+            GetWingPositions(playerPos, playerRot, flapAmount, &leftWing, &rightWing);
+        }
+    }
+    PROFILE_END();
+    
+    // Check goal collision
+    if (currentLevelData.goal.x != 0 || currentLevelData.goal.y != 0) {
+        if (Vector2Distance(playerPos, currentLevelData.goal) < 40) {
+            // Goal reached! Load next level
+            currentLevel++;
+            LoadLevel(currentLevel);
+            ResetPlayer((Vector2){100, 100});
+        }
+    }
 }
 
 void ScreenGameplay_Update(void) {
-    float delta = GetFrameTime();
+    float delta = GetScreenFrameTime();
     Vector2 mousePos = GetScreenToWorld2D(GetMousePosition(), camera);
     
     // Handle back to menu
@@ -191,18 +498,17 @@ void ScreenGameplay_Update(void) {
         return;
     }
     
-    // Update graph data
-    graphUpdateTimer += delta;
-    if (graphUpdateTimer >= 0.05f) {
-        graphUpdateTimer = 0.0f;
-        flapVelocityHistory[graphIndex] = flapVelocity;
-        flapAmountHistory[graphIndex] = flapAmount;
-        playerVelocityMagnitudeHistory[graphIndex] = Vector2Length(playerVelocity);
-        graphIndex = (graphIndex + 1) % GRAPH_SAMPLES;
-    }
+    World_Stream(camera.target);
+    
+    // Update graph data; each channel keeps one sample per interval
+    Telemetry_Push(flapVelocityChannel, flapVelocity);
+    Telemetry_Push(flapAmountChannel, flapAmount);
+    Telemetry_Push(playerSpeedChannel, Vector2Length(playerVelocity));
+    SyncTelemetryGraphs();
     
     if (IsKeyPressed(KEY_P)) {
         editMode = !editMode;
+        levelRevision++; // the editor draws LOD levels
         if (editMode) {
             editPos = playerPos;
         }
@@ -214,93 +520,31 @@ void ScreenGameplay_Update(void) {
     if (IsKeyPressed(KEY_H)) {
         debugInfoEnabled = !debugInfoEnabled;
     }
+    if (IsKeyPressed(KEY_J)) {
+        profilerOverlayEnabled = !profilerOverlayEnabled;
+    }
+    if (IsKeyPressed(KEY_R)) {
+        levelRenderMode = (levelRenderMode + 1) % LEVEL_RENDER_MODE_COUNT;
+    }
+    if (IsKeyPressed(KEY_F)) {
+        dynamicResolutionEnabled = !dynamicResolutionEnabled;
+    }
     
     if (IsKeyPressed(KEY_SPACE)) {
-        playerRot = 0.0;
-        playerPos = (Vector2){100, 100};
-        playerVelocity = (Vector2){0, 0};
+        ResetPlayer((Vector2){100, 100});
     }
     
     if (!editMode) {
         // PLAYMODE
-        if (IsKeyDown(KEY_RIGHT)) {
-            playerRot += ROT_SPEED * delta;
+        if (IsKeyPressed(KEY_LEFT) || IsKeyPressed(KEY_RIGHT) || IsKeyPressed(KEY_DOWN)) {
+            InputLatency_InputSeen();
         }
-        
-        if (IsKeyDown(KEY_LEFT)) {
-            playerRot -= ROT_SPEED * delta;
-        }
-        
-        if (IsKeyDown(KEY_DOWN)) {
-            if (flapAmount < 90.0) {
-                flapVelocity += 30.0 * delta + flapVelocity;
-            }
-            if (flapVelocity > 2000.0) flapVelocity = 2000.0;
-            flapAmount += flapVelocity;
-            if (flapAmount >= 90.0) {
-                flapAmount = 90.0;
-                flapVelocity = 0;
-            }
-        } else {
-            flapVelocity = 0;
-            flapAmount -= 500.0 * delta;
-            if (flapAmount < 0.0) flapAmount = 0.0;
-        }
-        
-        Vector2 velocityFromFlapVector = Vector2Rotate((Vector2){0, -flapVelocity * 8 * delta}, DEG2RAD * playerRot);
-        playerVelocity = Vector2Add(velocityFromFlapVector, playerVelocity);
-        
-        // gravity
-        playerVelocity = Vector2Add(playerVelocity, (Vector2){0, 10 * delta});
-        
-        playerPos = Vector2Add(playerPos, playerVelocity);
-        
-        // Camera follows player with smooth movement
-        float distance = Vector2Distance(playerPos, camera.target);
-        if (distance > 100.0) {
-            Vector2 difference = Vector2Subtract(playerPos, camera.target);
-            Vector2 direction = Vector2Normalize(difference);
-            Vector2 targetPos = Vector2Add(camera.target, Vector2Scale(direction, distance - 100.0));
-            camera.target = targetPos;
-        }
-        
-        leftWing = (Vector2){-WING_WIDTH, 0};
-        rightWing = (Vector2){WING_WIDTH, 0};
-        leftWing = Vector2Rotate(leftWing, playerRot * DEG2RAD);
-        rightWing = Vector2Rotate(rightWing, playerRot * DEG2RAD);
-        leftWing = Vector2Rotate(leftWing, -flapAmount * DEG2RAD);
-        rightWing = Vector2Rotate(rightWing, flapAmount * DEG2RAD);
-        leftWing = Vector2Add(leftWing, playerPos);
-        rightWing = Vector2Add(rightWing, playerPos);
-        
-        // Collision detection
-        for (int i = 0; i < currentLevelData.segmentCount; i++) {
-            if (CollisionWithLine(playerPos, leftWing, rightWing,
-                                currentLevelData.segments[i].start, currentLevelData.segments[i].end)) {
-                playerRot = 0.0;
-                playerPos = (Vector2){100, 50};
-                playerVelocity = (Vector2){0, 0};
-                leftWing = (Vector2){-WING_WIDTH, 0};
-                rightWing = (Vector2){WING_WIDTH, 0};
-                leftWing = Vector2Rotate(leftWing, playerRot * DEG2RAD);
-                rightWing = Vector2Rotate(rightWing, playerRot * DEG2RAD);
-                leftWing = Vector2Rotate(leftWing, -flapAmount * DEG2RAD);
-                rightWing = Vector2Rotate(rightWing, flapAmount * DEG2RAD);
-                leftWing = Vector2Add(leftWing, playerPos);
-                rightWing = Vector2Add(rightWing, playerPos);
-            }
-        }
-        
-        // Check goal collision
-        if (currentLevelData.goal.x != 0 || currentLevelData.goal.y != 0) {
-            if (Vector2Distance(playerPos, currentLevelData.goal) < 40) {
-                // Goal reached! Load next level
-                currentLevel++;
-                load_level(&currentLevelData, TextFormat("level%d", currentLevel));
-                playerRot = 0.0;
-                playerPos = (Vector2){100, 100};
-                playerVelocity = (Vector2){0, 0};
-            }
+        simAccumulator += fminf(delta, SIM_MAX_FRAME_TIME);
+        while (simAccumulator >= SIM_TICK) {
+            simPrevious = CaptureSimState();
+            SimulateTick(SIM_TICK);
+            simAccumulator -= SIM_TICK;
+            InputLatency_Ticked(IsKeyDown(KEY_LEFT) || IsKeyDown(KEY_RIGHT) || IsKeyDown(KEY_DOWN));
         }
     } else {
         // EDITMODE
@@ -310,8 +554,11 @@ void ScreenGameplay_Update(void) {
         if (IsKeyDown(KEY_UP)) editPos.y -= editSpeed * delta;
         if (IsKeyDown(KEY_DOWN)) editPos.y += editSpeed * delta;
         
-        if (IsKeyPressed(KEY_S)) {
-            save_level(&currentLevelData, TextFormat("level%d", currentLevel));
+        // Streamed worlds are read-only in the editor
+        bool editable = !World_IsOpen();
+        
+        if (editable && IsKeyPressed(KEY_S)) {
+            LevelJournal_Compact();
         }
         if (IsKeyPressed(KEY_D)) {
             editModeCurrent = (editModeCurrent + 1) % 3;
@@ -319,53 +566,63 @@ void ScreenGameplay_Update(void) {
         
         if (IsKeyPressed(KEY_N)) {
             currentLevel++;
-            load_level(&currentLevelData, TextFormat("level%d", currentLevel));
+            LoadLevel(currentLevel);
         }
         if (IsKeyPressed(KEY_B)) {
             currentLevel--;
-            load_level(&currentLevelData, TextFormat("level%d", currentLevel));
+            LoadLevel(currentLevel);
         }
         
-        switch (editModeCurrent) {
-            case EDIT_LINES_ADD:
-                if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
-                    Vector2 pressedPos = GetScreenToWorld2D(GetMousePosition(), camera);
-                    clickCircle = pressedPos;
-                    if (editModeStartOfCurrentSegment) {
-                        editModeStartPosition = pressedPos;
-                    } else {
-                        currentLevelData.segments[currentLevelData.segmentCount++] = (LineSegment){editModeStartPosition, pressedPos};
+        if (editable) {
+            switch (editModeCurrent) {
+                case EDIT_LINES_ADD:
+                    if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
+                        Vector2 pressedPos = GetScreenToWorld2D(GetMousePosition(), camera);
+                        clickCircle = pressedPos;
+                        if (editModeStartOfCurrentSegment) {
+                            editModeStartPosition = pressedPos;
+                        } else if (currentLevelData.segmentCount < MAX_SEGMENTS) {
+                            LineSegment segment = {editModeStartPosition, pressedPos};
+                            currentLevelData.segments[currentLevelData.segmentCount++] = segment;
+                            LevelJournal_AddSegment(segment);
+                            LevelSegmentsChanged(currentLevelData.segmentCount - 1);
+                        }
+                        editModeStartOfCurrentSegment = !editModeStartOfCurrentSegment;
                     }
-                    editModeStartOfCurrentSegment = !editModeStartOfCurrentSegment;
-                }
-                break;
-            case EDIT_LINES_REMOVE:
-                if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
-                    int segmentClicked = -1;
-                    for (int i = 0; i < currentLevelData.segmentCount; i++) {
-                        if (CollisionWithLine(mousePos,
-                                            (Vector2){mousePos.x + 5, mousePos.y + 5},
-                                            (Vector2){mousePos.x - 5, mousePos.y - 5},
-                                            currentLevelData.segments[i].start, currentLevelData.segments[i].end)) {
-                            segmentClicked = i;
-                            break;
+                    break;
+                case EDIT_LINES_REMOVE:
+                    if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
+                        int segmentClicked = -1;
+                        Rectangle mouseArea = {mousePos.x - 5, mousePos.y - 5, 15, 15}; // covers the probe lines below
+                        int nearCount = QueryLevelSegments(mouseArea, querySegments, SEGMENT_QUERY_MAX);
+                        for (int i = 0; i < nearCount; i++) {
+                            if (CollisionWithLine(mousePos,
+                                                (Vector2){mousePos.x + 5, mousePos.y + 5},
+                                                (Vector2){mousePos.x - 5, mousePos.y - 5},
+                                                querySegments[i]->start, querySegments[i]->end)) {
+                                segmentClicked = (int)(querySegments[i] - currentLevelData.segments);
+                                break;
+                            }
+                        }
+                        if (segmentClicked != -1) {
+                            if (currentLevelData.segmentCount == 1) break;
+                            currentLevelData.segments[segmentClicked] = currentLevelData.segments[currentLevelData.segmentCount - 1];
+                            currentLevelData.segmentCount--;
+                            LevelJournal_RemoveSegment(segmentClicked);
+                            LevelSegmentsChanged(segmentClicked);
                         }
                     }
-                    if (segmentClicked != -1) {
-                        if (currentLevelData.segmentCount == 1) break;
-                        currentLevelData.segments[segmentClicked] = currentLevelData.segments[currentLevelData.segmentCount - 1];
-                        currentLevelData.segmentCount--;
-                        save_level(&currentLevelData, TextFormat("level%d", currentLevel));
+                    break;
+                case EDIT_GOAL_PLACE:
+                    if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
+                        currentLevelData.goal = mousePos;
+                        LevelJournal_SetGoal(mousePos);
+                        levelRevision++;
                     }
-                }
-                break;
-            case EDIT_GOAL_PLACE:
-                if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
-                    currentLevelData.goal = mousePos;
-                }
-                break;
-            default:
-                break;
+                    break;
+                default:
+                    break;
+            }
         }
         
         camera.zoom = expf(logf(camera.zoom) + ((float)GetMouseWheelMove() * 0.1f));
@@ -374,52 +631,110 @@ void ScreenGameplay_Update(void) {
         
         camera.target = editPos;
     }
+    
+    // Nothing to blend in edit mode or across a teleport
+    if (editMode || simTeleported) {
+        simPrevious = CaptureSimState();
+        simTeleported = false;
+        InputLatency_Cancel();
+    }
 }
 
 void ScreenGameplay_Draw(void) {
-    BeginDrawing();
+    int screenWidth = GetScreenWidth();
+    int screenHeight = GetScreenHeight();
+    enum LevelRenderMode renderMode = levelRenderMode;
+    if (renderMode == LEVEL_RENDER_MESH && World_IsOpen()) renderMode = LEVEL_RENDER_IMMEDIATE;
     
-    ClearBackground((Color){20,20,20,255});
+    // Blend between the last two simulation ticks
+    SimState state = InterpolateSimState(simAccumulator / SIM_TICK);
+    Camera2D view = camera;
+    view.target = state.cameraTarget;
+    Vector2 left, right;
+    GetWingPositions(state.playerPos, state.playerRot, state.flapAmount, &left, &right);
     
-    BeginMode2D(camera);
+    // With dynamic resolution the scene is drawn scaled down into the top-left
+    // of an offscreen target
+    float sceneScale = dynamicResolutionEnabled && dynamicResolution.scale > 0 ? dynamicResolution.scale : 1.0f;
+    int sceneWidth = (int)(screenWidth * sceneScale);
+    int sceneHeight = (int)(screenHeight * sceneScale);
+    Camera2D sceneView = view;
+    sceneView.offset = Vector2Scale(view.offset, sceneScale);
+    sceneView.zoom = view.zoom * sceneScale;
     
-    // Draw player
-    DrawLineEx(leftWing, playerPos, WING_THICKNESS, WHITE);
-    DrawLineEx(playerPos, rightWing, WING_THICKNESS, WHITE);
+    BeginDrawing();
     
-    DrawCircleV(clickCircle, 20, RED);
+    // Redraw the cached level layer only when the view or the level changed
+    if (renderMode == LEVEL_RENDER_CACHED) {
+        unsigned int revision = levelRevision + World_Revision();
+        if (LayerCache_NeedsRedraw(&levelCache, sceneView, sceneWidth, sceneHeight, revision)) {
+            Camera2D cacheCamera = LayerCache_Begin(&levelCache, sceneView, sceneWidth, sceneHeight, revision);
+            BeginMode2D(cacheCamera);
+            DrawLevelSegments(cacheCamera, sceneWidth + 2 * LAYER_CACHE_MARGIN, sceneHeight + 2 * LAYER_CACHE_MARGIN);
+            DrawGoal();
+            EndMode2D();
+            LayerCache_End(&levelCache);
+        }
+    }
     
-    // Draw level segments
-    for (int i = 0; i < currentLevelData.segmentCount; i++) {
-        DrawLineEx(currentLevelData.segments[i].start, currentLevelData.segments[i].end, SEGMENT_THICKNESS, RAYWHITE);
+    if (dynamicResolutionEnabled) {
+        DynamicResolution_Begin(&dynamicResolution);
     }
     
-    // Draw goal
-    if (currentLevelData.goal.x != 0 || currentLevelData.goal.y != 0) {
-        DrawCircleV(currentLevelData.goal, 30, GREEN);
-        DrawCircleV(currentLevelData.goal, 25, DARKGREEN);
+    ClearBackground((Color){20,20,20,255});
+    
+    enum LevelRenderMode sceneMode = renderMode;
+    if (renderMode == LEVEL_RENDER_CACHED) {
+        LayerCache_Draw(&levelCache, sceneView);
+    } else if (renderMode == LEVEL_RENDER_SDF &&
+               !DrawSceneSdf(sceneView, state.playerPos, left, right, sceneWidth, sceneHeight)) {
+        sceneMode = LEVEL_RENDER_IMMEDIATE;
+    }
+    
+    BeginMode2D(sceneView);
+    
+    // Draw player, level segments and goal
+    switch (sceneMode) {
+        case LEVEL_RENDER_IMMEDIATE:
+            DrawPlayer(state.playerPos, left, right);
+            DrawLevelSegments(sceneView, sceneWidth, sceneHeight);
+            DrawGoal();
+            break;
+        case LEVEL_RENDER_MESH:
+            DrawPlayer(state.playerPos, left, right);
+            LevelMesh_Draw(&levelMesh);
+            DrawGoal();
+            break;
+        case LEVEL_RENDER_CACHED:
+            DrawPlayer(state.playerPos, left, right);
+            break;
+        default:
+            break;
     }
     
     if (editMode) {
-        Vector2 mousePos = GetScreenToWorld2D(GetMousePosition(), camera);
+        Vector2 mousePos = GetScreenToWorld2D(GetMousePosition(), view);
         
         switch (editModeCurrent) {
             case EDIT_LINES_ADD:
                 break;
-            case EDIT_LINES_REMOVE:
-                for (int i = 0; i < currentLevelData.segmentCount; i++) {
+            case EDIT_LINES_REMOVE: {
+                Rectangle mouseArea = {mousePos.x - 5, mousePos.y - 5, 15, 15}; // covers the probe lines below
+                int nearCount = QueryLevelSegments(mouseArea, querySegments, SEGMENT_QUERY_MAX);
+                for (int i = 0; i < nearCount; i++) {
                     if (CollisionWithLine(mousePos, (Vector2){mousePos.x + 5, mousePos.y + 5}, (Vector2){mousePos.x - 5, mousePos.y - 5},
-                                        currentLevelData.segments[i].start, currentLevelData.segments[i].end)) {
-                        DrawLineEx(currentLevelData.segments[i].start, currentLevelData.segments[i].end, SEGMENT_THICKNESS, YELLOW);
-                        DrawCircleV(currentLevelData.segments[i].start, 20, YELLOW);
-                        DrawCircleV(currentLevelData.segments[i].end, 20, YELLOW);
+                                        querySegments[i]->start, querySegments[i]->end)) {
+                        DrawLineCounted(querySegments[i]->start, querySegments[i]->end, SEGMENT_THICKNESS, YELLOW);
+                        DrawCircleCounted(querySegments[i]->start, 20, YELLOW);
+                        DrawCircleCounted(querySegments[i]->end, 20, YELLOW);
                     }
                 }
                 break;
+            }
             case EDIT_GOAL_PLACE:
                 // Show goal preview at mouse position
-                DrawCircleV(mousePos, 30, (Color){0, 255, 0, 100});
-                DrawCircleV(mousePos, 25, (Color){0, 150, 0, 100});
+                DrawCircleCounted(mousePos, 30, (Color){0, 255, 0, 100});
+                DrawCircleCounted(mousePos, 25, (Color){0, 150, 0, 100});
                 break;
             default:
                 break;
@@ -427,40 +742,106 @@ void ScreenGameplay_Draw(void) {
     }
     
     EndMode2D();
+    
+    if (dynamicResolutionEnabled) {
+        DynamicResolution_End(&dynamicResolution);
+    }
+    
+    // The HUD is always drawn at native resolution
+    HudText_Begin(&hudText);
     int textY = 10;
     int textLineHeight = 25;
     if(debugInfoEnabled) {
-        // Draw HUD text with debug info
-        DrawText(TextFormat("Flap Velocity: %.2f", flapVelocity), 10, textY+=textLineHeight, 20, WHITE);
-        DrawText(TextFormat("Flap Amount: %.2f", flapAmount), 10, textY+=textLineHeight, 20, WHITE);
-        DrawText(TextFormat("Player Velocity: (%.2f, %.2f)", playerVelocity.x, playerVelocity.y), 10, textY+=textLineHeight, 20, WHITE);
-        DrawText(TextFormat("Player Rotation: %.2f", playerRot), 10, textY+=textLineHeight, 20, WHITE);
-        DrawText(TextFormat("Current Level: %d", currentLevel), 10, textY+=textLineHeight, 20, WHITE);
-        DrawText(TextFormat("Edit Mode: %s", EditModeToString(editModeCurrent)), 10, textY+=textLineHeight, 20, WHITE);
+        // Draw HUD text with debug info; per-frame values refresh at about 10 Hz
+        HudText_Printf(&hudText, HUD_FLAP_VELOCITY, 10, textY+=textLineHeight, 20, WHITE, HUD_TEXT_THROTTLE, "Flap Velocity: %.2f", flapVelocity);
+        HudText_Printf(&hudText, HUD_FLAP_AMOUNT, 10, textY+=textLineHeight, 20, WHITE, HUD_TEXT_THROTTLE, "Flap Amount: %.2f", flapAmount);
+        HudText_Printf(&hudText, HUD_PLAYER_VELOCITY, 10, textY+=textLineHeight, 20, WHITE, HUD_TEXT_THROTTLE, "Player Velocity: (%.2f, %.2f)", playerVelocity.x, playerVelocity.y);
+        HudText_Printf(&hudText, HUD_PLAYER_ROTATION, 10, textY+=textLineHeight, 20, WHITE, HUD_TEXT_THROTTLE, "Player Rotation: %.2f", playerRot);
+        HudText_Printf(&hudText, HUD_CURRENT_LEVEL, 10, textY+=textLineHeight, 20, WHITE, 0, "Current Level: %d", currentLevel);
+        HudText_Printf(&hudText, HUD_EDIT_MODE, 10, textY+=textLineHeight, 20, WHITE, 0, "Edit Mode: %s", EditModeToString(editModeCurrent));
+        HudText_Printf(&hudText, HUD_RENDER_MODE, 10, textY+=textLineHeight, 20, WHITE, 0, "Render Mode: %s (R)", LevelRenderModeToString(levelRenderMode));
+        HudText_Printf(&hudText, HUD_RESOLUTION, 10, textY+=textLineHeight, 20, WHITE, 0, "Resolution: %s (F)",
+                       dynamicResolutionEnabled ? TextFormat("%d%%", (int)(sceneScale * 100 + 0.5f)) : "NATIVE");
+        // Counters and memory in a smaller font so they fit under the rest
+        int smallY = textY + textLineHeight;
+#ifndef NO_ENGINE_COUNTERS
+        for (int i = 0; i < ENGINE_COUNTER_COUNT; i++) {
+            HudText_Printf(&hudText, HUD_COUNTER_FIRST + i, 10, smallY, 14, WHITE, HUD_TEXT_THROTTLE, "%s: %u",
+                           EngineCounters_Name(i), EngineCounters_LastFrame(i));
+            smallY += 18;
+        }
+#endif
+        for (int i = 0; i < MEMORY_CATEGORY_COUNT; i++) {
+            HudText_Printf(&hudText, HUD_MEMORY_FIRST + i, 10, smallY, 14, LIGHTGRAY, HUD_TEXT_THROTTLE, "%s: %.1f KiB (peak %.1f KiB)",
+                           MemoryTracker_CategoryName(i), MemoryTracker_Current(i) / 1024.0, MemoryTracker_Peak(i) / 1024.0);
+            smallY += 18;
+        }
+        if (TelemetryLog_IsOpen()) {
+            HudText_Printf(&hudText, HUD_TELEMETRY_LOG, 10, smallY, 14, GRAY, 0, "Telemetry log: %.1f KiB mapped (file-backed)",
+                           TelemetryLog_MappedBytes() / 1024.0);
+            smallY += 18;
+        }
     }
     // DrawText("Press ESC to return to menu", 10, textY+=textLineHeight, 16, LIGHTGRAY);
     
     if (graphEnabled) {
-        // Draw graphs
-        float graphX = GetScreenWidth() - GRAPH_WIDTH - 10;
-        float graphY = 10;
+        // One graph per registered telemetry channel, shrunk to fit the
+        // screen; past GRAPH_MIN_HEIGHT they continue in another column
+        static const Color graphColors[] = { RED, BLUE, GREEN, ORANGE, PURPLE, SKYBLUE, PINK, GOLD };
+        int perColumn = (GetScreenHeight() - 10) / (GRAPH_MIN_HEIGHT + 5);
+        if (perColumn < 1) perColumn = 1;
+        int rows = telemetryGraphCount < perColumn ? telemetryGraphCount : perColumn;
+        float graphHeight = GRAPH_HEIGHT;
+        if (rows > 0 && (GetScreenHeight() - 10) / rows - 5 < graphHeight) {
+            graphHeight = (GetScreenHeight() - 10) / rows - 5;
+        }
         
-        DrawGraph(flapVelocityHistory, GRAPH_SAMPLES, graphIndex, graphX, graphY, GRAPH_WIDTH, GRAPH_HEIGHT, RED, "Flap Velocity");
-        DrawGraph(flapAmountHistory, GRAPH_SAMPLES, graphIndex, graphX, graphY + GRAPH_HEIGHT + 5, GRAPH_WIDTH, GRAPH_HEIGHT, BLUE, "Flap Amount");
-        DrawGraph(playerVelocityMagnitudeHistory, GRAPH_SAMPLES, graphIndex, graphX, graphY + 2 * (GRAPH_HEIGHT + 5), GRAPH_WIDTH, GRAPH_HEIGHT, GREEN, "Player Speed");
+        for (int i = 0; i < telemetryGraphCount; i++) {
+            float graphX = GetScreenWidth() - (i / perColumn + 1) * (GRAPH_WIDTH + 10);
+            float graphY = 10 + (i % perColumn) * (graphHeight + 5);
+            DrawGraph(&telemetryGraphs[i], graphX, graphY, GRAPH_WIDTH, graphHeight,
+                      graphColors[i % (sizeof(graphColors) / sizeof(graphColors[0]))], Telemetry_ChannelName(i), HUD_GRAPH_FIRST + 3 * i);
+        }
         
         if (editMode) {
-            DrawText("EDIT MODE - Press P to toggle", 10, GetScreenHeight() - 30, 20, YELLOW);
-            DrawText("S to save segments", 10, GetScreenHeight() - 55, 20, YELLOW);
+            HudText_Printf(&hudText, HUD_MODE_HINT, 10, GetScreenHeight() - 30, 20, YELLOW, 0, "EDIT MODE - Press P to toggle");
+            HudText_Printf(&hudText, HUD_SAVE_HINT, 10, GetScreenHeight() - 55, 20, YELLOW, 0, "S to save segments");
         } else {
-            DrawText("PLAY MODE - Press P to toggle", 10, GetScreenHeight() - 30, 20, GREEN);
+            HudText_Printf(&hudText, HUD_MODE_HINT, 10, GetScreenHeight() - 30, 20, GREEN, 0, "PLAY MODE - Press P to toggle");
         }
     }
+    HudText_Draw(&hudText);
     
+    if (profilerOverlayEnabled) {
+        Profiler_DrawTimeline(10, GetScreenHeight() - PROFILER_OVERLAY_HEIGHT - 70, PROFILER_OVERLAY_WIDTH, PROFILER_OVERLAY_HEIGHT);
+    }
+    
+    InputLatency_FrameSubmitted();
     EndDrawing();
+    InputLatency_FramePresented();
+}
+
+bool ScreenGameplay_CanIdle(void) {
+    // Play mode simulates every frame; the editor only changes on input
+    if (!editMode) return false;
+    return !IsKeyDown(KEY_LEFT) && !IsKeyDown(KEY_RIGHT) && !IsKeyDown(KEY_UP) && !IsKeyDown(KEY_DOWN) &&
+           !IsMouseButtonDown(MOUSE_BUTTON_LEFT);
 }
 
 void ScreenGameplay_Unload(void) {
     // Clean up gameplay resources
-    // No dynamic memory to free in this implementation
+    // Flushes pending edits into the level file
+    LevelJournal_Stop();
+    World_Close();
+    SegmentGrid_Free(&levelGrid);
+    SegmentLod_Free(&levelLod);
+    LevelMesh_Unload(&levelMesh);
+    LayerCache_Unload(&levelCache);
+    LevelSdf_Unload(&levelSdf);
+    for (int i = 0; i < telemetryGraphCount; i++) {
+        GraphChannel_Free(&telemetryGraphs[i]);
+    }
+    telemetryGraphCount = 0;
+    HudText_Unload(&hudText);
+    DynamicResolution_Unload(&dynamicResolution);
 }
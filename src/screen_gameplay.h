@@ -1,9 +1,12 @@
 #ifndef SCREEN_GAMEPLAY_H
 #define SCREEN_GAMEPLAY_H
 
+#include <stdbool.h>
+
 void ScreenGameplay_Init(void);
 void ScreenGameplay_Update(void);
 void ScreenGameplay_Draw(void);
 void ScreenGameplay_Unload(void);
+bool ScreenGameplay_CanIdle(void);
 
 #endif
@@ -1,6 +1,7 @@
 #include "screen_manager.h"
 #include "screen_gameplay.h"
 #include "screen_menu.h"
+#include "raylib.h"
 #include <stdbool.h>
 
 
@@ -12,6 +13,11 @@ static void (*Screen_Init[])(void) = {  ScreenMenu_Init, ScreenGameplay_Init };
 static void (*Screen_Update[])(void) = {  ScreenMenu_Update, ScreenGameplay_Update };
 static void (*Screen_Draw[])(void) = {  ScreenMenu_Draw, ScreenGameplay_Draw };
 static void (*Screen_Unload[])(void) = {  ScreenMenu_Unload, ScreenGameplay_Unload };
+static bool (*Screen_CanIdle[])(void) = {  ScreenMenu_CanIdle, ScreenGameplay_CanIdle };
+
+static double lastUpdateTime;
+static double idleTime;
+static float screenFrameTime;
 
 void ChangeToScreen(GameScreen screen)
 {
@@ -19,6 +25,11 @@ void ChangeToScreen(GameScreen screen)
     nextScreen = screen;
 }
 
+GameScreen GetCurrentScreen(void)
+{
+    return currentScreen;
+}
+
 void ProcessScreenChange(void)
 {
     if (screenChangeRequested)
@@ -30,7 +41,41 @@ void ProcessScreenChange(void)
     }
 }
 
+// Any key, click, wheel or mouse motion since the last input poll
+static bool InputArrived(void) {
+    if (GetKeyPressed() != 0) return true;
+    for (int button = MOUSE_BUTTON_LEFT; button <= MOUSE_BUTTON_MIDDLE; button++) {
+        if (IsMouseButtonPressed(button) || IsMouseButtonReleased(button)) return true;
+    }
+    Vector2 mouseDelta = GetMouseDelta();
+    return mouseDelta.x != 0 || mouseDelta.y != 0 || GetMouseWheelMove() != 0 || IsWindowResized();
+}
+
+// raylib only exposes blocking waits inside EndDrawing, which would also
+// drop the key transitions IsKeyPressed needs, so idle screens poll input
+// at a low rate instead of rendering
+bool WaitWhileIdle(void) {
+    if (screenChangeRequested || !Screen_CanIdle[currentScreen]()) return false;
+    double start = GetTime();
+    bool waited = false;
+    while (!InputArrived() && !WindowShouldClose() && GetTime() - start < IDLE_REDRAW_SECONDS) {
+        WaitTime(IDLE_POLL_SECONDS);
+        PollInputEvents();
+        waited = true;
+    }
+    idleTime += GetTime() - start;
+    return waited;
+}
+
+float GetScreenFrameTime(void) {
+    return screenFrameTime;
+}
+
 void Update(void) {
+    double now = GetTime();
+    screenFrameTime = lastUpdateTime > 0 ? (float)(now - lastUpdateTime - idleTime) : GetFrameTime();
+    lastUpdateTime = now;
+    idleTime = 0;
     Screen_Update[currentScreen]();
 }
 void Draw(void) {
@@ -2,13 +2,26 @@
 #ifndef SCREEN_MANAGER_H
 #define SCREEN_MANAGER_H
 
+#include <stdbool.h>
+
 // #include "screens.h"  // optional: just for the GameScreen enum
 
 typedef enum GameScreen { SCREEN_MENU, SCREEN_GAMEPLAY } GameScreen;
 
 void ChangeToScreen(GameScreen screen);
+GameScreen GetCurrentScreen(void);
 void ProcessScreenChange(void);
 
+// Idle screens (see Screen_CanIdle) skip Update and Draw until input
+// arrives, or IDLE_REDRAW_SECONDS pass so background changes still show
+#define IDLE_POLL_SECONDS 0.01
+#define IDLE_REDRAW_SECONDS 0.5
+
+// Returns whether it waited
+bool WaitWhileIdle(void);
+// Seconds since the previous Update, not counting time spent idle
+float GetScreenFrameTime(void);
+
 void Update(void);
 void Draw(void);
 void Unload(void);
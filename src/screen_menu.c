@@ -29,3 +29,8 @@ void ScreenMenu_Draw(void) {
 void ScreenMenu_Unload(void) {
     // Clean up menu resources
 }
+
+bool ScreenMenu_CanIdle(void) {
+    // Static text; only input changes anything
+    return true;
+}
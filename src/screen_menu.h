@@ -3,12 +3,14 @@
 #define SCREEN_MENU_H
 
 #include "raylib.h"
+#include <stdbool.h>
 
 // Forward declarations
 void ScreenMenu_Init(void);
 void ScreenMenu_Update(void);
 void ScreenMenu_Draw(void);
 void ScreenMenu_Unload(void);
+bool ScreenMenu_CanIdle(void);
 
 #ifdef SCREEN_MENU_IMPLEMENTATION
 
@@ -40,6 +42,10 @@ void ScreenMenu_Unload(void) {
     // Clean up menu resources
 }
 
+bool ScreenMenu_CanIdle(void) {
+    return true;
+}
+
 #endif // SCREEN_MENU_IMPLEMENTATION
 
 #endif // SCREEN_MENU_H
@@ -0,0 +1,124 @@
+#include "segment_grid.h"
+#include "memory_tracker.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int GridCell(float v, float origin, float cellSize, int cells) {
+    int cell = (int)floorf((v - origin) / cellSize);
+    if (cell < 0) return 0;
+    if (cell >= cells) return cells - 1;
+    return cell;
+}
+
+void SegmentGrid_Free(SegmentGrid* grid) {
+    MemoryTracker_Free(grid->cellStart);
+    MemoryTracker_Free(grid->cellItems);
+    MemoryTracker_Free(grid->stamps);
+    memset(grid, 0, sizeof(*grid));
+}
+
+void SegmentGrid_Build(SegmentGrid* grid, const LineSegment* segments, int segmentCount) {
+    SegmentGrid_Free(grid);
+    grid->segments = segments;
+    grid->segmentCount = segmentCount;
+    if (segmentCount == 0) return;
+
+    float minX = segments[0].start.x, maxX = minX;
+    float minY = segments[0].start.y, maxY = minY;
+    for (int i = 0; i < segmentCount; i++) {
+        minX = fminf(minX, fminf(segments[i].start.x, segments[i].end.x));
+        maxX = fmaxf(maxX, fmaxf(segments[i].start.x, segments[i].end.x));
+        minY = fminf(minY, fminf(segments[i].start.y, segments[i].end.y));
+        maxY = fmaxf(maxY, fmaxf(segments[i].start.y, segments[i].end.y));
+    }
+    float cellSize = SEGMENT_GRID_CELL_SIZE;
+    cellSize = fmaxf(cellSize, (maxX - minX) / (SEGMENT_GRID_MAX_DIM - 1));
+    cellSize = fmaxf(cellSize, (maxY - minY) / (SEGMENT_GRID_MAX_DIM - 1));
+    grid->cellSize = cellSize;
+    grid->originX = minX;
+    grid->originY = minY;
+    grid->cols = (int)((maxX - minX) / cellSize) + 1;
+    grid->rows = (int)((maxY - minY) / cellSize) + 1;
+    if (grid->cols > SEGMENT_GRID_MAX_DIM) grid->cols = SEGMENT_GRID_MAX_DIM;
+    if (grid->rows > SEGMENT_GRID_MAX_DIM) grid->rows = SEGMENT_GRID_MAX_DIM;
+
+    int cellCount = grid->cols * grid->rows;
+    grid->cellStart = MemoryTracker_Calloc(MEMORY_SPATIAL_INDEX, cellCount + 1, sizeof(int));
+    grid->stamps = MemoryTracker_Calloc(MEMORY_SPATIAL_INDEX, segmentCount, sizeof(unsigned int));
+    if (!grid->cellStart || !grid->stamps) {
+        SegmentGrid_Free(grid);
+        return;
+    }
+
+    // Count, prefix-sum, then fill; cellStart[c + 1] is the fill cursor of cell c
+    for (int pass = 0; pass < 2; pass++) {
+        for (int i = 0; i < segmentCount; i++) {
+            const LineSegment* s = &segments[i];
+            int c0 = GridCell(fminf(s->start.x, s->end.x), minX, cellSize, grid->cols);
+            int c1 = GridCell(fmaxf(s->start.x, s->end.x), minX, cellSize, grid->cols);
+            int r0 = GridCell(fminf(s->start.y, s->end.y), minY, cellSize, grid->rows);
+            int r1 = GridCell(fmaxf(s->start.y, s->end.y), minY, cellSize, grid->rows);
+            for (int r = r0; r <= r1; r++) {
+                for (int c = c0; c <= c1; c++) {
+                    int cell = r * grid->cols + c;
+                    if (pass == 0) grid->cellStart[cell + 1]++;
+                    else grid->cellItems[grid->cellStart[cell + 1]++] = i;
+                }
+            }
+        }
+        if (pass == 0) {
+            for (int c = 0; c < cellCount; c++) {
+                grid->cellStart[c + 1] += grid->cellStart[c];
+            }
+            grid->cellItems = MemoryTracker_Alloc(MEMORY_SPATIAL_INDEX, (grid->cellStart[cellCount] > 0 ? grid->cellStart[cellCount] : 1) * sizeof(int));
+            if (!grid->cellItems) {
+                SegmentGrid_Free(grid);
+                return;
+            }
+            // Shift so the fill cursors start at each cell's first slot
+            memmove(grid->cellStart + 1, grid->cellStart, cellCount * sizeof(int));
+            grid->cellStart[0] = 0;
+        }
+    }
+}
+
+int SegmentGrid_Query(SegmentGrid* grid, Rectangle area, int* out, int maxOut) {
+    if (!grid->cellStart) return 0;
+    float gridMaxX = grid->originX + grid->cols * grid->cellSize;
+    float gridMaxY = grid->originY + grid->rows * grid->cellSize;
+    if (area.x > gridMaxX || area.x + area.width < grid->originX ||
+        area.y > gridMaxY || area.y + area.height < grid->originY) {
+        return 0;
+    }
+
+    if (++grid->stamp == 0) {
+        memset(grid->stamps, 0, grid->segmentCount * sizeof(unsigned int));
+        grid->stamp = 1;
+    }
+    int c0 = GridCell(area.x, grid->originX, grid->cellSize, grid->cols);
+    int c1 = GridCell(area.x + area.width, grid->originX, grid->cellSize, grid->cols);
+    int r0 = GridCell(area.y, grid->originY, grid->cellSize, grid->rows);
+    int r1 = GridCell(area.y + area.height, grid->originY, grid->cellSize, grid->rows);
+
+    int found = 0;
+    for (int r = r0; r <= r1; r++) {
+        for (int c = c0; c <= c1; c++) {
+            int cell = r * grid->cols + c;
+            for (int k = grid->cellStart[cell]; k < grid->cellStart[cell + 1]; k++) {
+                int i = grid->cellItems[k];
+                if (grid->stamps[i] == grid->stamp) continue;
+                grid->stamps[i] = grid->stamp;
+
+                const LineSegment* s = &grid->segments[i];
+                if (fmaxf(s->start.x, s->end.x) < area.x || fminf(s->start.x, s->end.x) > area.x + area.width ||
+                    fmaxf(s->start.y, s->end.y) < area.y || fminf(s->start.y, s->end.y) > area.y + area.height) {
+                    continue;
+                }
+                out[found++] = i;
+                if (found == maxOut) return found;
+            }
+        }
+    }
+    return found;
+}
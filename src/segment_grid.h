@@ -0,0 +1,33 @@
+#ifndef SEGMENT_GRID_H
+#define SEGMENT_GRID_H
+
+#include "level.h"
+
+// Uniform grid over a segment array for area queries. Segments are
+// registered in every cell their bounding box touches; the grid is capped
+// at SEGMENT_GRID_MAX_DIM cells per axis by growing the cell size.
+
+#define SEGMENT_GRID_CELL_SIZE 256.0f
+#define SEGMENT_GRID_MAX_DIM 64
+
+typedef struct {
+    const LineSegment* segments;
+    int segmentCount;
+    float cellSize;
+    float originX;
+    float originY;
+    int cols;
+    int rows;
+    int* cellStart; // cols * rows + 1 offsets into cellItems
+    int* cellItems;
+    unsigned int* stamps; // per segment, to report each once per query
+    unsigned int stamp;
+} SegmentGrid;
+
+void SegmentGrid_Build(SegmentGrid* grid, const LineSegment* segments, int segmentCount);
+void SegmentGrid_Free(SegmentGrid* grid);
+
+// Indices of the segments whose bounding box overlaps area
+int SegmentGrid_Query(SegmentGrid* grid, Rectangle area, int* out, int maxOut);
+
+#endif
@@ -0,0 +1,90 @@
+#include "segment_lod.h"
+#include "memory_tracker.h"
+#include "raymath.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+void SegmentLod_Free(SegmentLod* lod) {
+    for (int k = 0; k <= SEGMENT_LOD_LEVELS; k++) {
+        MemoryTracker_Free(lod->segments[k]);
+    }
+    memset(lod, 0, sizeof(*lod));
+}
+
+static float DistanceToSegment(Vector2 p, LineSegment s) {
+    Vector2 ab = Vector2Subtract(s.end, s.start);
+    float lengthSqr = Vector2LengthSqr(ab);
+    float t = lengthSqr > 0 ? Clamp(Vector2DotProduct(Vector2Subtract(p, s.start), ab) / lengthSqr, 0.0f, 1.0f) : 0.0f;
+    return Vector2Distance(p, Vector2Add(s.start, Vector2Scale(ab, t)));
+}
+
+// Joins a and b into one segment if they share an endpoint and the shared
+// point stays within tolerance of the joined line
+static bool TryMerge(LineSegment a, LineSegment b, float tolerance, LineSegment* merged) {
+    Vector2 aEnds[2] = { a.start, a.end };
+    Vector2 bEnds[2] = { b.start, b.end };
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 2; j++) {
+            if (Vector2Distance(aEnds[i], bEnds[j]) > tolerance) continue;
+            LineSegment candidate = { aEnds[1 - i], bEnds[1 - j] };
+            if (DistanceToSegment(aEnds[i], candidate) <= tolerance &&
+                DistanceToSegment(bEnds[j], candidate) <= tolerance) {
+                *merged = candidate;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Simplifies segments[0..count) in place; returns the new count
+static int Simplify(LineSegment* segments, int count, float tolerance) {
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int i = 0; i < count; i++) {
+            for (int j = i + 1; j < count; j++) {
+                LineSegment merged;
+                bool covered = DistanceToSegment(segments[j].start, segments[i]) <= tolerance &&
+                               DistanceToSegment(segments[j].end, segments[i]) <= tolerance;
+                if (covered || TryMerge(segments[i], segments[j], tolerance, &merged)) {
+                    if (!covered) segments[i] = merged;
+                    segments[j--] = segments[--count];
+                    changed = true;
+                }
+            }
+        }
+    }
+    int kept = 0;
+    for (int i = 0; i < count; i++) {
+        if (Vector2Distance(segments[i].start, segments[i].end) >= tolerance) {
+            segments[kept++] = segments[i];
+        }
+    }
+    return kept;
+}
+
+void SegmentLod_Build(SegmentLod* lod, const LineSegment* segments, int segmentCount) {
+    SegmentLod_Free(lod);
+    // Every level starts from the full-resolution segments so its error
+    // stays within its own tolerance instead of adding up across levels
+    for (int k = 1; k <= SEGMENT_LOD_LEVELS; k++) {
+        lod->segments[k] = MemoryTracker_Alloc(MEMORY_RENDER_CACHES, (segmentCount > 0 ? segmentCount : 1) * sizeof(LineSegment));
+        if (!lod->segments[k]) {
+            SegmentLod_Free(lod);
+            return;
+        }
+        memcpy(lod->segments[k], segments, segmentCount * sizeof(LineSegment));
+        lod->counts[k] = Simplify(lod->segments[k], segmentCount, (float)(1 << k));
+    }
+}
+
+int SegmentLod_LevelForZoom(float zoom) {
+    int level = 0;
+    float pixel = 1.0f / zoom;
+    while (level < SEGMENT_LOD_LEVELS && (float)(2 << level) <= pixel) {
+        level++;
+    }
+    return level;
+}
@@ -0,0 +1,31 @@
+#ifndef SEGMENT_LOD_H
+#define SEGMENT_LOD_H
+
+#include "level.h"
+
+// Simplified copies of a level's segments for drawing zoomed out. Level k
+// (1..SEGMENT_LOD_LEVELS) is built from the original segments with a
+// tolerance of 2^k world units: segments that chain end to end and stay within the tolerance
+// of a straight line are merged, segments lying within the tolerance of
+// another are dropped, and what is left shorter than the tolerance is
+// skipped. A level is only used once the tolerance is below one pixel.
+//
+// Simplifying is O(n^3) and every level is rebuilt on each edit, which is
+// only affordable because it runs on a Level (at most MAX_SEGMENTS
+// segments); streamed worlds are drawn without LOD.
+
+#define SEGMENT_LOD_LEVELS 6
+
+typedef struct {
+    LineSegment* segments[SEGMENT_LOD_LEVELS + 1]; // [0] is unused
+    int counts[SEGMENT_LOD_LEVELS + 1];
+} SegmentLod;
+
+void SegmentLod_Build(SegmentLod* lod, const LineSegment* segments, int segmentCount);
+void SegmentLod_Free(SegmentLod* lod);
+
+// Coarsest level whose tolerance fits in one pixel at zoom; 0 means draw the
+// original segments
+int SegmentLod_LevelForZoom(float zoom);
+
+#endif
@@ -0,0 +1,117 @@
+#include "segment_pack.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Values snap to the absolute grid before the origin is subtracted, so the
+// same point decodes to the same float whatever origin it was stored under
+static bool Quantize(float value, float origin, int32_t* out) {
+    float q = roundf(value * SEGMENT_PACK_SCALE) - roundf(origin * SEGMENT_PACK_SCALE);
+    if (!(q >= INT16_MIN && q <= INT16_MAX)) return false; // also rejects NaN
+    *out = (int32_t)q;
+    return true;
+}
+
+static float Dequantize(int32_t q, float origin) {
+    return (roundf(origin * SEGMENT_PACK_SCALE) + (float)q) / SEGMENT_PACK_SCALE;
+}
+
+float SegmentPack_SnapValue(float value) {
+    return roundf(value * SEGMENT_PACK_SCALE) / SEGMENT_PACK_SCALE;
+}
+
+static uint32_t ZigZag(int32_t v) {
+    return ((uint32_t)v << 1) ^ (v < 0 ? 0xFFFFFFFFu : 0u);
+}
+
+static int32_t UnZigZag(uint32_t v) {
+    return (int32_t)(v >> 1) ^ -(int32_t)(v & 1u);
+}
+
+static bool PutVarint(unsigned char* out, size_t capacity, size_t* pos, uint32_t v) {
+    do {
+        if (*pos >= capacity) return false;
+        unsigned char byte = v & 0x7F;
+        v >>= 7;
+        out[(*pos)++] = byte | (v ? 0x80 : 0);
+    } while (v);
+    return true;
+}
+
+static bool GetVarint(const unsigned char* data, size_t size, size_t* pos, uint32_t* v) {
+    *v = 0;
+    for (int shift = 0; shift < 32; shift += 7) {
+        if (*pos >= size) return false;
+        unsigned char byte = data[(*pos)++];
+        *v |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+size_t SegmentPack_Encode(const LineSegment* segments, int count, Vector2 origin, unsigned char* out, size_t capacity) {
+    size_t pos = 0;
+    int32_t prevX = 0;
+    int32_t prevY = 0;
+    for (int i = 0; i < count; i++) {
+        int32_t sx, sy, ex, ey;
+        if (!Quantize(segments[i].start.x, origin.x, &sx) || !Quantize(segments[i].start.y, origin.y, &sy) ||
+            !Quantize(segments[i].end.x, origin.x, &ex) || !Quantize(segments[i].end.y, origin.y, &ey)) {
+            return 0;
+        }
+
+        bool ok;
+        if (i > 0 && sx == prevX && sy == prevY) {
+            ok = PutVarint(out, capacity, &pos, 1);
+        } else {
+            ok = PutVarint(out, capacity, &pos, ZigZag(sx - prevX) << 1) &&
+                 PutVarint(out, capacity, &pos, ZigZag(sy - prevY));
+        }
+        ok = ok && PutVarint(out, capacity, &pos, ZigZag(ex - sx)) &&
+                   PutVarint(out, capacity, &pos, ZigZag(ey - sy));
+        if (!ok) return 0;
+
+        prevX = ex;
+        prevY = ey;
+    }
+    return pos;
+}
+
+int SegmentPack_Decode(const unsigned char* data, size_t size, Vector2 origin, LineSegment* out, int count) {
+    size_t pos = 0;
+    int32_t prevX = 0;
+    int32_t prevY = 0;
+    for (int i = 0; i < count; i++) {
+        uint32_t head, v;
+        int32_t sx = prevX;
+        int32_t sy = prevY;
+        if (!GetVarint(data, size, &pos, &head)) return -1;
+        if (!(head & 1u)) {
+            sx += UnZigZag(head >> 1);
+            if (!GetVarint(data, size, &pos, &v)) return -1;
+            sy += UnZigZag(v);
+        }
+        if (!GetVarint(data, size, &pos, &v)) return -1;
+        int32_t ex = sx + UnZigZag(v);
+        if (!GetVarint(data, size, &pos, &v)) return -1;
+        int32_t ey = sy + UnZigZag(v);
+
+        out[i].start = (Vector2){ Dequantize(sx, origin.x), Dequantize(sy, origin.y) };
+        out[i].end = (Vector2){ Dequantize(ex, origin.x), Dequantize(ey, origin.y) };
+        prevX = ex;
+        prevY = ey;
+    }
+    return 0;
+}
+
+void SegmentPack_Snap(LineSegment* segments, int count, Vector2 origin) {
+    for (int i = 0; i < count; i++) {
+        Vector2* points[2] = { &segments[i].start, &segments[i].end };
+        for (int p = 0; p < 2; p++) {
+            int32_t qx, qy;
+            if (Quantize(points[p]->x, origin.x, &qx) && Quantize(points[p]->y, origin.y, &qy)) {
+                *points[p] = (Vector2){ Dequantize(qx, origin.x), Dequantize(qy, origin.y) };
+            }
+        }
+    }
+}
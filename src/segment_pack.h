@@ -0,0 +1,27 @@
+#ifndef SEGMENT_PACK_H
+#define SEGMENT_PACK_H
+
+#include "level.h"
+#include <stddef.h>
+
+// Compact segment encoding used by level and world files. Endpoints are
+// snapped to an absolute 1/SEGMENT_PACK_SCALE grid, stored as 16-bit offsets
+// from the origin's grid point and written as zigzag varint deltas from the
+// previous endpoint. A point decodes to the same value under any origin.
+// A segment that starts where the previous one ended stores only its end.
+
+#define SEGMENT_PACK_SCALE 4.0f
+#define SEGMENT_PACK_RANGE (32767.0f / SEGMENT_PACK_SCALE) // max distance from origin
+#define SEGMENT_PACK_MAX_BYTES(count) ((size_t)(count) * 12)
+
+// Returns the encoded size, or 0 if a coordinate is out of range or the
+// output does not fit.
+size_t SegmentPack_Encode(const LineSegment* segments, int count, Vector2 origin, unsigned char* out, size_t capacity);
+int SegmentPack_Decode(const unsigned char* data, size_t size, Vector2 origin, LineSegment* out, int count);
+
+// Snaps segments to the grid they would be stored at
+void SegmentPack_Snap(LineSegment* segments, int count, Vector2 origin);
+// The grid value a coordinate decodes to, with no range limit
+float SegmentPack_SnapValue(float value);
+
+#endif
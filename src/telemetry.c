@@ -0,0 +1,82 @@
+#include "telemetry.h"
+#include <string.h>
+#include <time.h>
+
+typedef struct {
+    const char* name;
+    float interval;
+    double lastSample; // writer only
+    float ring[TELEMETRY_RING_SIZE];
+    uint32_t head;     // atomic; written by the channel's writer only
+} TelemetryChannel;
+
+static TelemetryChannel telemetryChannels[TELEMETRY_MAX_CHANNELS];
+static int telemetryChannelCount; // atomic
+
+static double TelemetryNow(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int Telemetry_Register(const char* name, float interval) {
+    int count = __atomic_load_n(&telemetryChannelCount, __ATOMIC_ACQUIRE);
+    for (int i = 0; i < count; i++) {
+        if (strcmp(telemetryChannels[i].name, name) == 0) {
+            telemetryChannels[i].interval = interval;
+            return i;
+        }
+    }
+    if (count == TELEMETRY_MAX_CHANNELS) return -1;
+    TelemetryChannel* channel = &telemetryChannels[count];
+    memset(channel, 0, sizeof(*channel));
+    channel->name = name;
+    channel->interval = interval;
+    channel->lastSample = -1e9;
+    __atomic_store_n(&telemetryChannelCount, count + 1, __ATOMIC_RELEASE);
+    return count;
+}
+
+void Telemetry_Push(int channel, float value) {
+    if (channel < 0 || channel >= TELEMETRY_MAX_CHANNELS) return;
+    TelemetryChannel* c = &telemetryChannels[channel];
+    if (c->interval > 0) {
+        double now = TelemetryNow();
+        if (now - c->lastSample < c->interval) return;
+        c->lastSample = now;
+    }
+    uint32_t head = __atomic_load_n(&c->head, __ATOMIC_RELAXED);
+    __atomic_store(&c->ring[head & (TELEMETRY_RING_SIZE - 1)], &value, __ATOMIC_RELAXED);
+    __atomic_store_n(&c->head, head + 1, __ATOMIC_RELEASE);
+}
+
+int Telemetry_ChannelCount(void) {
+    return __atomic_load_n(&telemetryChannelCount, __ATOMIC_ACQUIRE);
+}
+
+const char* Telemetry_ChannelName(int channel) {
+    return telemetryChannels[channel].name;
+}
+
+uint32_t Telemetry_Head(int channel) {
+    return __atomic_load_n(&telemetryChannels[channel].head, __ATOMIC_ACQUIRE);
+}
+
+int Telemetry_Read(int channel, uint32_t* cursor, float* out, int max) {
+    TelemetryChannel* c = &telemetryChannels[channel];
+    uint32_t head = __atomic_load_n(&c->head, __ATOMIC_ACQUIRE);
+    uint32_t from = *cursor;
+    if (head - from > TELEMETRY_RING_SIZE) from = head - TELEMETRY_RING_SIZE;
+    if (head - from > (uint32_t)max) from = head - (uint32_t)max;
+    int count = 0;
+    for (uint32_t seq = from; seq != head; seq++) {
+        __atomic_load(&c->ring[seq & (TELEMETRY_RING_SIZE - 1)], &out[count++], __ATOMIC_RELAXED);
+    }
+    // Drop anything the writer lapped while we were copying
+    uint32_t after = __atomic_load_n(&c->head, __ATOMIC_ACQUIRE);
+    int skip = after - from > TELEMETRY_RING_SIZE ? (int)(after - from - TELEMETRY_RING_SIZE) : 0;
+    if (skip > count) skip = count;
+    if (skip > 0) memmove(out, out + skip, (count - skip) * sizeof(float));
+    *cursor = head;
+    return count - skip;
+}
@@ -0,0 +1,29 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+
+// Registry of named float series. Each channel has one writer, which pushes
+// every frame; a sample is kept at most once per channel interval, into a
+// lock-free ring of TELEMETRY_RING_SIZE samples published with an atomic
+// head, so any thread can read while the writer keeps going.
+
+#define TELEMETRY_MAX_CHANNELS 16
+#define TELEMETRY_RING_SIZE 1024 // power of two
+
+// Returns the channel id, or -1 when the registry is full. Registering an
+// existing name returns its id and updates the interval. interval is in
+// seconds; 0 keeps every sample
+int Telemetry_Register(const char* name, float interval);
+void Telemetry_Push(int channel, float value);
+
+int Telemetry_ChannelCount(void);
+const char* Telemetry_ChannelName(int channel);
+// Sequence number of the next sample the channel will write
+uint32_t Telemetry_Head(int channel);
+// Copies samples from *cursor up to the head into out (at most max, oldest
+// first) and advances *cursor; samples overwritten before they were read
+// are skipped. Returns the count
+int Telemetry_Read(int channel, uint32_t* cursor, float* out, int max);
+
+#endif
@@ -0,0 +1,91 @@
+#include "telemetry_log.h"
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define TELEMETRY_LOG_SIZE (sizeof(TelemetryLogHeader) + (size_t)TELEMETRY_LOG_RECORDS * sizeof(TelemetryLogRecord))
+
+static TelemetryLogHeader* telemetryLogHeader;
+static TelemetryLogRecord* telemetryLogRecords;
+static uint64_t telemetryLogSequence; // last written
+
+int TelemetryLog_Open(const char* filename) {
+    TelemetryLog_Close();
+    int fd = open(filename, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) return -1;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return -1;
+    }
+    bool fresh = info.st_size == 0;
+    if (!fresh && (size_t)info.st_size != TELEMETRY_LOG_SIZE) {
+        close(fd);
+        return -1;
+    }
+    // Reserve the blocks up front so a full disk fails here, not as a
+    // SIGBUS on some later frame
+    if (fresh && posix_fallocate(fd, 0, TELEMETRY_LOG_SIZE) != 0) {
+        close(fd);
+        return -1;
+    }
+    void* map = mmap(NULL, TELEMETRY_LOG_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return -1;
+
+    TelemetryLogHeader* header = map;
+    if (fresh) {
+        header->magic = TELEMETRY_LOG_MAGIC;
+        header->version = TELEMETRY_LOG_VERSION;
+        header->recordSize = sizeof(TelemetryLogRecord);
+        header->recordCount = TELEMETRY_LOG_RECORDS;
+    } else if (header->magic != TELEMETRY_LOG_MAGIC || header->version != TELEMETRY_LOG_VERSION ||
+               header->recordSize != sizeof(TelemetryLogRecord) || header->recordCount != TELEMETRY_LOG_RECORDS) {
+        munmap(map, TELEMETRY_LOG_SIZE);
+        return -1;
+    }
+    telemetryLogHeader = header;
+    telemetryLogRecords = (TelemetryLogRecord*)(header + 1);
+
+    telemetryLogSequence = 0;
+    for (int i = 0; i < TELEMETRY_LOG_RECORDS; i++) {
+        if (telemetryLogRecords[i].sequence > telemetryLogSequence) telemetryLogSequence = telemetryLogRecords[i].sequence;
+    }
+    return 0;
+}
+
+void TelemetryLog_Close(void) {
+    if (!telemetryLogHeader) return;
+    msync(telemetryLogHeader, TELEMETRY_LOG_SIZE, MS_SYNC);
+    munmap(telemetryLogHeader, TELEMETRY_LOG_SIZE);
+    telemetryLogHeader = NULL;
+    telemetryLogRecords = NULL;
+}
+
+bool TelemetryLog_IsOpen(void) {
+    return telemetryLogHeader != NULL;
+}
+
+size_t TelemetryLog_MappedBytes(void) {
+    return telemetryLogHeader ? TELEMETRY_LOG_SIZE : 0;
+}
+
+void TelemetryLog_Append(TelemetryLogRecord* record) {
+    if (!telemetryLogHeader) return;
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    record->wallTimeMs = (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+    record->sequence = ++telemetryLogSequence;
+
+    // Clear the sequence before the body so a crash mid-copy leaves the
+    // slot marked unwritten rather than holding a mixed record
+    TelemetryLogRecord* slot = &telemetryLogRecords[(record->sequence - 1) % TELEMETRY_LOG_RECORDS];
+    __atomic_store_n(&slot->sequence, 0, __ATOMIC_RELEASE);
+    memcpy((char*)slot + sizeof(slot->sequence), (const char*)record + sizeof(record->sequence),
+           sizeof(TelemetryLogRecord) - sizeof(record->sequence));
+    __atomic_store_n(&slot->sequence, record->sequence, __ATOMIC_RELEASE);
+}
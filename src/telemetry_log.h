@@ -0,0 +1,57 @@
+#ifndef TELEMETRY_LOG_H
+#define TELEMETRY_LOG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Per-frame telemetry appended to a memory-mapped ring file for long
+// sessions. The file is preallocated when opened: a header, then
+// TELEMETRY_LOG_RECORDS fixed-size records that wrap around. Appending is a
+// copy into the mapping, with no stdio or allocation; the kernel writes the
+// pages back, so the log survives the process crashing. Records are
+// ordered by sequence number, and a record with sequence 0 is unwritten or
+// was torn by a crash. Reopening a log continues after its newest record.
+// tools/telemetry_csv converts a log to CSV.
+
+#define TELEMETRY_LOG_MAGIC 0x4C544657u // "WFTL" in a little-endian file
+#define TELEMETRY_LOG_VERSION 1
+#ifndef TELEMETRY_LOG_RECORDS
+#define TELEMETRY_LOG_RECORDS (1 << 20) // 64 MiB, about 4.8 hours at 60 fps
+#endif
+#define TELEMETRY_LOG_COUNTERS 8
+
+#define TELEMETRY_LOG_IDLE 1u // the frame waited for input first
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t recordCount;
+    uint8_t reserved[48];
+} TelemetryLogHeader; // 64 bytes
+
+typedef struct {
+    uint64_t sequence;  // 1-based; written last
+    int64_t wallTimeMs; // CLOCK_REALTIME
+    float frameMs;
+    int32_t screen;     // GameScreen
+    uint32_t flags;     // TELEMETRY_LOG_*
+    uint32_t reserved;
+    uint32_t counters[TELEMETRY_LOG_COUNTERS]; // EngineCounter order
+} TelemetryLogRecord; // 64 bytes
+
+// Returns 0 on success; -1 if the file cannot be created, sized or mapped,
+// or exists with a different layout
+int TelemetryLog_Open(const char* filename);
+void TelemetryLog_Close(void);
+bool TelemetryLog_IsOpen(void);
+// Size of the file-backed mapping, 0 when closed. Its pages are page cache
+// the kernel can write back and drop, so it is reported apart from the
+// MemoryTracker totals
+size_t TelemetryLog_MappedBytes(void);
+
+// Fills in the sequence and wall time; a no-op when no log is open
+void TelemetryLog_Append(TelemetryLogRecord* record);
+
+#endif
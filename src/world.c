@@ -0,0 +1,397 @@
+#include "world.h"
+#include "segment_pack.h"
+#include "memory_tracker.h"
+#include "profiler.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define WORLD_MAGIC 0x32575746u // "FWW2"
+#define WORLD_CHUNK_PACKED 1u
+
+typedef struct {
+    uint32_t magic;
+    uint32_t chunkCount;
+    float chunkSize;
+    Vector2 goal;
+} WorldHeader;
+
+// Chunk table entry; the table is sorted by (cy, cx)
+typedef struct {
+    int32_t cx;
+    int32_t cy;
+    uint32_t offset; // file offset of the chunk's segments
+    uint32_t byteSize;
+    uint32_t segmentCount;
+    uint32_t flags; // WORLD_CHUNK_PACKED: SegmentPack data relative to the chunk origin, else raw LineSegments
+} WorldChunkEntry;
+
+typedef struct {
+    const WorldChunkEntry* entry; // NULL while the slot is free
+    unsigned int lastUsed;
+    bool loading;  // request handed to the loader
+    bool resident; // segments may be queried
+    // Filled by the loader, handed over to the main thread under worldMutex
+    bool loaded;
+    LineSegment* segments;
+    int segmentCount;
+} WorldChunk;
+
+typedef struct {
+    int32_t cx;
+    int32_t cy;
+    int32_t segment;
+} WorldChunkRef;
+
+static bool worldOpen;
+static FILE* worldFile;
+static WorldHeader worldHeader;
+static WorldChunkEntry* worldTable;
+static WorldChunk worldChunks[WORLD_MAX_RESIDENT];
+static unsigned int worldFrame;
+static unsigned int worldRevision;
+
+static pthread_t worldThread;
+static pthread_mutex_t worldMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t worldWork = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t worldLoaded = PTHREAD_COND_INITIALIZER;
+static int worldQueue[WORLD_MAX_RESIDENT];
+static int worldQueueHead;
+static int worldQueueCount;
+static bool worldRunning;
+
+static int ChunkCoord(float v) {
+    return (int)floorf(v / WORLD_CHUNK_SIZE);
+}
+
+static int CompareChunkRefs(const void* a, const void* b) {
+    const WorldChunkRef* ra = a;
+    const WorldChunkRef* rb = b;
+    if (ra->cy != rb->cy) return ra->cy < rb->cy ? -1 : 1;
+    if (ra->cx != rb->cx) return ra->cx < rb->cx ? -1 : 1;
+    return ra->segment - rb->segment;
+}
+
+static int CompareChunkEntries(const void* a, const void* b) {
+    const WorldChunkEntry* ea = a;
+    const WorldChunkEntry* eb = b;
+    if (ea->cy != eb->cy) return ea->cy < eb->cy ? -1 : 1;
+    if (ea->cx != eb->cx) return ea->cx < eb->cx ? -1 : 1;
+    return 0;
+}
+
+// Each segment is stored in every chunk its bounding box touches
+int World_Write(const char* filename, const LineSegment* segments, int segmentCount, Vector2 goal) {
+    int refCount = 0;
+    for (int i = 0; i < segmentCount; i++) {
+        const LineSegment* s = &segments[i];
+        int spanX = ChunkCoord(fmaxf(s->start.x, s->end.x)) - ChunkCoord(fminf(s->start.x, s->end.x)) + 1;
+        int spanY = ChunkCoord(fmaxf(s->start.y, s->end.y)) - ChunkCoord(fminf(s->start.y, s->end.y)) + 1;
+        refCount += spanX * spanY;
+    }
+
+    WorldChunkRef* refs = malloc((refCount > 0 ? refCount : 1) * sizeof(WorldChunkRef));
+    if (!refs) return -1;
+    int r = 0;
+    for (int i = 0; i < segmentCount; i++) {
+        const LineSegment* s = &segments[i];
+        for (int cy = ChunkCoord(fminf(s->start.y, s->end.y)); cy <= ChunkCoord(fmaxf(s->start.y, s->end.y)); cy++) {
+            for (int cx = ChunkCoord(fminf(s->start.x, s->end.x)); cx <= ChunkCoord(fmaxf(s->start.x, s->end.x)); cx++) {
+                refs[r++] = (WorldChunkRef){ cx, cy, i };
+            }
+        }
+    }
+    qsort(refs, refCount, sizeof(WorldChunkRef), CompareChunkRefs);
+
+    int chunkCount = 0;
+    for (int i = 0; i < refCount; i++) {
+        if (i == 0 || refs[i].cx != refs[i - 1].cx || refs[i].cy != refs[i - 1].cy) chunkCount++;
+    }
+
+    // Encode every chunk first so the table can hold the payload offsets
+    WorldChunkEntry* entries = malloc((chunkCount > 0 ? chunkCount : 1) * sizeof(WorldChunkEntry));
+    LineSegment* chunkSegments = malloc((refCount > 0 ? refCount : 1) * sizeof(LineSegment));
+    unsigned char* payload = malloc((refCount > 0 ? refCount : 1) * sizeof(LineSegment));
+    if (!entries || !chunkSegments || !payload) {
+        free(entries);
+        free(chunkSegments);
+        free(payload);
+        free(refs);
+        return -1;
+    }
+    uint32_t payloadOffset = sizeof(WorldHeader) + chunkCount * sizeof(WorldChunkEntry);
+    size_t payloadSize = 0;
+    int chunk = 0;
+    for (int i = 0; i < refCount; chunk++) {
+        WorldChunkEntry* entry = &entries[chunk];
+        *entry = (WorldChunkEntry){ refs[i].cx, refs[i].cy, payloadOffset + (uint32_t)payloadSize, 0, 0, 0 };
+        while (i < refCount && refs[i].cx == entry->cx && refs[i].cy == entry->cy) {
+            // Snapped even when stored raw, so every copy of a segment
+            // decodes to the same endpoints and World_Query can dedup them
+            LineSegment s = segments[refs[i].segment];
+            s.start = (Vector2){ SegmentPack_SnapValue(s.start.x), SegmentPack_SnapValue(s.start.y) };
+            s.end = (Vector2){ SegmentPack_SnapValue(s.end.x), SegmentPack_SnapValue(s.end.y) };
+            chunkSegments[entry->segmentCount++] = s;
+            i++;
+        }
+        size_t rawSize = entry->segmentCount * sizeof(LineSegment);
+        Vector2 origin = { entry->cx * WORLD_CHUNK_SIZE, entry->cy * WORLD_CHUNK_SIZE };
+        size_t packedSize = SegmentPack_Encode(chunkSegments, entry->segmentCount, origin, payload + payloadSize, rawSize);
+        if (packedSize > 0) {
+            entry->byteSize = (uint32_t)packedSize;
+            entry->flags = WORLD_CHUNK_PACKED;
+        } else {
+            memcpy(payload + payloadSize, chunkSegments, rawSize);
+            entry->byteSize = (uint32_t)rawSize;
+        }
+        payloadSize += entry->byteSize;
+    }
+
+    int result = -1;
+    FILE* file = fopen(filename, "wb");
+    if (file) {
+        WorldHeader header = { WORLD_MAGIC, (uint32_t)chunkCount, WORLD_CHUNK_SIZE, goal };
+        fwrite(&header, sizeof(header), 1, file);
+        fwrite(entries, sizeof(WorldChunkEntry), chunkCount, file);
+        fwrite(payload, 1, payloadSize, file);
+        result = ferror(file) ? -1 : 0;
+        fclose(file);
+    }
+    free(entries);
+    free(chunkSegments);
+    free(payload);
+    free(refs);
+    return result;
+}
+
+static void* WorldLoaderThread(void* arg) {
+    (void)arg;
+    PROFILE_THREAD_NAME("world loader");
+    pthread_mutex_lock(&worldMutex);
+    while (true) {
+        while (worldRunning && worldQueueCount == 0) {
+            pthread_cond_wait(&worldWork, &worldMutex);
+        }
+        if (!worldRunning) break;
+
+        int slot = worldQueue[worldQueueHead];
+        worldQueueHead = (worldQueueHead + 1) % WORLD_MAX_RESIDENT;
+        worldQueueCount--;
+        const WorldChunkEntry* entry = worldChunks[slot].entry;
+        pthread_mutex_unlock(&worldMutex);
+
+        uint64_t zoneStart = PROFILE_NOW();
+        LineSegment* segments = MemoryTracker_Alloc(MEMORY_LEVEL_DATA, (entry->segmentCount > 0 ? entry->segmentCount : 1) * sizeof(LineSegment));
+        unsigned char* data = MemoryTracker_Alloc(MEMORY_LEVEL_DATA, entry->byteSize > 0 ? entry->byteSize : 1);
+        int segmentCount = 0;
+        if (segments && data && fseek(worldFile, (long)entry->offset, SEEK_SET) == 0 &&
+            fread(data, 1, entry->byteSize, worldFile) == entry->byteSize) {
+            Vector2 origin = { entry->cx * WORLD_CHUNK_SIZE, entry->cy * WORLD_CHUNK_SIZE };
+            if (!(entry->flags & WORLD_CHUNK_PACKED)) {
+                if (entry->byteSize == entry->segmentCount * sizeof(LineSegment)) {
+                    memcpy(segments, data, entry->byteSize);
+                    segmentCount = (int)entry->segmentCount;
+                }
+            } else if (SegmentPack_Decode(data, entry->byteSize, origin, segments, (int)entry->segmentCount) == 0) {
+                segmentCount = (int)entry->segmentCount;
+            }
+        }
+        MemoryTracker_Free(data);
+        PROFILE_THREAD_ZONE("LoadChunk", zoneStart);
+
+        pthread_mutex_lock(&worldMutex);
+        worldChunks[slot].segments = segments;
+        worldChunks[slot].segmentCount = segmentCount;
+        worldChunks[slot].loaded = true;
+        pthread_cond_broadcast(&worldLoaded);
+    }
+    pthread_mutex_unlock(&worldMutex);
+    return NULL;
+}
+
+bool World_Open(const char* filename) {
+    World_Close();
+    FILE* file = fopen(filename, "rb");
+    if (!file) return false;
+    if (fread(&worldHeader, sizeof(worldHeader), 1, file) != 1 ||
+        worldHeader.magic != WORLD_MAGIC || worldHeader.chunkSize != WORLD_CHUNK_SIZE) {
+        fclose(file);
+        return false;
+    }
+    worldTable = MemoryTracker_Alloc(MEMORY_LEVEL_DATA, (worldHeader.chunkCount > 0 ? worldHeader.chunkCount : 1) * sizeof(WorldChunkEntry));
+    if (!worldTable || fread(worldTable, sizeof(WorldChunkEntry), worldHeader.chunkCount, file) != worldHeader.chunkCount) {
+        MemoryTracker_Free(worldTable);
+        worldTable = NULL;
+        fclose(file);
+        return false;
+    }
+
+    worldFile = file;
+    memset(worldChunks, 0, sizeof(worldChunks));
+    worldFrame = 0;
+    worldRevision++;
+    worldQueueHead = 0;
+    worldQueueCount = 0;
+    worldRunning = true;
+    worldOpen = true;
+    pthread_create(&worldThread, NULL, WorldLoaderThread, NULL);
+    return true;
+}
+
+void World_Close(void) {
+    if (!worldOpen) return;
+    pthread_mutex_lock(&worldMutex);
+    worldRunning = false;
+    pthread_cond_signal(&worldWork);
+    pthread_mutex_unlock(&worldMutex);
+    pthread_join(worldThread, NULL);
+
+    for (int i = 0; i < WORLD_MAX_RESIDENT; i++) {
+        MemoryTracker_Free(worldChunks[i].segments);
+    }
+    memset(worldChunks, 0, sizeof(worldChunks));
+    MemoryTracker_Free(worldTable);
+    worldTable = NULL;
+    fclose(worldFile);
+    worldFile = NULL;
+    worldOpen = false;
+}
+
+bool World_IsOpen(void) {
+    return worldOpen;
+}
+
+Vector2 World_Goal(void) {
+    return worldHeader.goal;
+}
+
+unsigned int World_Revision(void) {
+    return worldRevision;
+}
+
+static const WorldChunkEntry* FindChunk(int cx, int cy) {
+    WorldChunkEntry key = { cx, cy, 0, 0, 0, 0 };
+    return bsearch(&key, worldTable, worldHeader.chunkCount, sizeof(WorldChunkEntry), CompareChunkEntries);
+}
+
+// Free slot, or the least recently used one not needed this frame
+static int ClaimSlot(void) {
+    int best = -1;
+    for (int i = 0; i < WORLD_MAX_RESIDENT; i++) {
+        WorldChunk* chunk = &worldChunks[i];
+        if (!chunk->entry) return i;
+        if (chunk->loading || chunk->lastUsed == worldFrame) continue;
+        if (best < 0 || chunk->lastUsed < worldChunks[best].lastUsed) best = i;
+    }
+    return best;
+}
+
+// Caller holds worldMutex
+static void TakeLoadedChunksLocked(void) {
+    for (int i = 0; i < WORLD_MAX_RESIDENT; i++) {
+        WorldChunk* chunk = &worldChunks[i];
+        if (chunk->loading && chunk->loaded) {
+            chunk->loading = false;
+            chunk->loaded = false;
+            chunk->resident = true;
+            worldRevision++;
+        }
+    }
+}
+
+void World_Stream(Vector2 center) {
+    if (!worldOpen) return;
+    worldFrame++;
+
+    pthread_mutex_lock(&worldMutex);
+    TakeLoadedChunksLocked();
+    pthread_mutex_unlock(&worldMutex);
+
+    int centerX = ChunkCoord(center.x);
+    int centerY = ChunkCoord(center.y);
+    for (int cy = centerY - WORLD_STREAM_RADIUS; cy <= centerY + WORLD_STREAM_RADIUS; cy++) {
+        for (int cx = centerX - WORLD_STREAM_RADIUS; cx <= centerX + WORLD_STREAM_RADIUS; cx++) {
+            const WorldChunkEntry* entry = FindChunk(cx, cy);
+            if (!entry) continue;
+
+            bool present = false;
+            for (int i = 0; i < WORLD_MAX_RESIDENT; i++) {
+                if (worldChunks[i].entry == entry) {
+                    worldChunks[i].lastUsed = worldFrame;
+                    present = true;
+                    break;
+                }
+            }
+            if (present) continue;
+
+            int slot = ClaimSlot();
+            if (slot < 0) continue;
+            WorldChunk* chunk = &worldChunks[slot];
+            if (chunk->resident) worldRevision++;
+            MemoryTracker_Free(chunk->segments);
+            *chunk = (WorldChunk){ .entry = entry, .lastUsed = worldFrame, .loading = true };
+
+            pthread_mutex_lock(&worldMutex);
+            worldQueue[(worldQueueHead + worldQueueCount) % WORLD_MAX_RESIDENT] = slot;
+            worldQueueCount++;
+            pthread_cond_signal(&worldWork);
+            pthread_mutex_unlock(&worldMutex);
+        }
+    }
+}
+
+void World_Prefetch(Vector2 center) {
+    if (!worldOpen) return;
+    World_Stream(center);
+    pthread_mutex_lock(&worldMutex);
+    for (int i = 0; i < WORLD_MAX_RESIDENT; i++) {
+        while (worldChunks[i].loading && !worldChunks[i].loaded) {
+            pthread_cond_wait(&worldLoaded, &worldMutex);
+        }
+    }
+    TakeLoadedChunksLocked();
+    pthread_mutex_unlock(&worldMutex);
+}
+
+// Copies of one segment in different chunks compare equal by endpoints
+static bool AlreadyFound(const LineSegment* segment, const LineSegment** found, int count) {
+    for (int i = 0; i < count; i++) {
+        if (found[i]->start.x == segment->start.x && found[i]->start.y == segment->start.y &&
+            found[i]->end.x == segment->end.x && found[i]->end.y == segment->end.y) return true;
+    }
+    return false;
+}
+
+int World_Query(Rectangle area, const LineSegment** out, int maxOut) {
+    int found = 0;
+    if (!worldOpen) return 0;
+    for (int i = 0; i < WORLD_MAX_RESIDENT; i++) {
+        const WorldChunk* chunk = &worldChunks[i];
+        if (!chunk->resident) continue;
+        float chunkX = chunk->entry->cx * WORLD_CHUNK_SIZE;
+        float chunkY = chunk->entry->cy * WORLD_CHUNK_SIZE;
+        if (chunkX + WORLD_CHUNK_SIZE < area.x || chunkX > area.x + area.width ||
+            chunkY + WORLD_CHUNK_SIZE < area.y || chunkY > area.y + area.height) continue;
+
+        for (int s = 0; s < chunk->segmentCount; s++) {
+            const LineSegment* segment = &chunk->segments[s];
+            float minX = fminf(segment->start.x, segment->end.x);
+            float minY = fminf(segment->start.y, segment->end.y);
+            float maxX = fmaxf(segment->start.x, segment->end.x);
+            float maxY = fmaxf(segment->start.y, segment->end.y);
+            if (maxX < area.x || minX > area.x + area.width || maxY < area.y || minY > area.y + area.height) continue;
+
+            // A segment spanning several chunks is stored in each of them;
+            // report the first resident copy so it stays visible while any
+            // of its chunks is loaded
+            bool spansChunks = ChunkCoord(minX) != ChunkCoord(maxX) || ChunkCoord(minY) != ChunkCoord(maxY);
+            if (spansChunks && AlreadyFound(segment, out, found)) continue;
+
+            out[found++] = segment;
+            if (found == maxOut) return found;
+        }
+    }
+    return found;
+}
@@ -0,0 +1,34 @@
+#ifndef WORLD_H
+#define WORLD_H
+
+#include "level.h"
+#include <stdbool.h>
+
+// Streamed worlds: "levelN.world" files too large to keep in one Level. The
+// world is cut into WORLD_CHUNK_SIZE squares; chunks within
+// WORLD_STREAM_RADIUS of the camera are read by a loader thread and kept in
+// an LRU cache of WORLD_MAX_RESIDENT chunks. Only resident chunks are
+// visible to World_Query.
+
+#define WORLD_CHUNK_SIZE 1024.0f
+#define WORLD_STREAM_RADIUS 2
+#define WORLD_MAX_RESIDENT 48
+
+int World_Write(const char* filename, const LineSegment* segments, int segmentCount, Vector2 goal);
+
+bool World_Open(const char* filename);
+void World_Close(void);
+bool World_IsOpen(void);
+Vector2 World_Goal(void);
+// Changes whenever the set of resident chunks does
+unsigned int World_Revision(void);
+
+// Requests the chunks around center and marks them used; call once a frame
+void World_Stream(Vector2 center);
+// Like World_Stream, but waits until the chunks around center are resident
+void World_Prefetch(Vector2 center);
+
+// Resident segments overlapping area, each reported once
+int World_Query(Rectangle area, const LineSegment** out, int maxOut);
+
+#endif
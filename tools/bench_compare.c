@@ -0,0 +1,143 @@
+// Compares a benchmark run against a stored baseline, both written by a
+// benchmark's --json option, e.g.
+//
+//   bench_geom --json baseline.json      (once, on the reference build)
+//   bench_geom --json current.json
+//   bench_compare baseline.json current.json [--k 3]
+//
+// A benchmark regresses when its median got slower by more than k times the
+// pooled standard error of the two medians, sqrt(se_base^2 + se_current^2).
+// Each run's per-sample sigma is estimated from the MAD (1.4826 * MAD for
+// normal noise), and the median of its n samples has a standard error of
+// about 1.2533 * sigma / sqrt(n), with n read from the run's "samples"
+// header. Noisy benchmarks therefore need a larger slowdown to be flagged
+// than quiet ones. Exits with 1 if anything regressed and 2 on a usage or file error.
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_COMPARE_MAX 256
+#define BENCH_COMPARE_DEFAULT_K 3.0
+#define MAD_TO_SIGMA 1.4826
+#define MEDIAN_STANDARD_ERROR 1.2533 // sqrt(pi / 2), times sigma / sqrt(n)
+
+typedef struct {
+    char name[64];
+    double median;
+    double mad;
+} BenchEntry;
+
+typedef struct {
+    BenchEntry entries[BENCH_COMPARE_MAX];
+    int count;
+    int samples; // per benchmark, from the header
+} BenchRun;
+
+// The benchmarks write one object per line; lines without a name are the
+// surrounding array and are skipped
+static int LoadRun(const char* filename, BenchRun* run) {
+    FILE* file = fopen(filename, "r");
+    if (!file) {
+        perror(filename);
+        return -1;
+    }
+    run->count = 0;
+    run->samples = 0;
+    char line[512];
+    int lineNumber = 0;
+    while (fgets(line, sizeof(line), file)) {
+        lineNumber++;
+        const char* samples = strstr(line, "\"samples\":");
+        if (samples) sscanf(samples, "\"samples\": %d", &run->samples);
+        const char* name = strstr(line, "\"name\": \"");
+        if (!name) continue;
+        const char* median = strstr(line, "\"median_ns\":");
+        const char* mad = strstr(line, "\"mad_ns\":");
+        BenchEntry* entry = &run->entries[run->count];
+        if (!median || !mad || sscanf(name, "\"name\": \"%63[^\"]\"", entry->name) != 1 ||
+            sscanf(median, "\"median_ns\": %lf", &entry->median) != 1 ||
+            sscanf(mad, "\"mad_ns\": %lf", &entry->mad) != 1) {
+            fprintf(stderr, "%s:%d: malformed benchmark entry\n", filename, lineNumber);
+            fclose(file);
+            return -1;
+        }
+        if (++run->count == BENCH_COMPARE_MAX) break;
+    }
+    fclose(file);
+    if (run->samples < 1) {
+        fprintf(stderr, "%s: missing sample count\n", filename);
+        return -1;
+    }
+    return 0;
+}
+
+// Standard error of a median of samples with the given MAD
+static double MedianError(double mad, int samples) {
+    return MEDIAN_STANDARD_ERROR * MAD_TO_SIGMA * mad / sqrt((double)samples);
+}
+
+static const BenchEntry* FindEntry(const BenchRun* run, const char* name) {
+    for (int i = 0; i < run->count; i++) {
+        if (strcmp(run->entries[i].name, name) == 0) return &run->entries[i];
+    }
+    return NULL;
+}
+
+int main(int argc, char** argv) {
+    const char* paths[2];
+    int pathCount = 0;
+    double k = BENCH_COMPARE_DEFAULT_K;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--k") == 0 && i + 1 < argc) {
+            k = atof(argv[++i]);
+        } else if (pathCount < 2) {
+            paths[pathCount++] = argv[i];
+        } else {
+            pathCount = 3;
+        }
+    }
+    if (pathCount != 2 || k <= 0) {
+        fprintf(stderr, "usage: %s <baseline.json> <current.json> [--k sigmas]\n", argv[0]);
+        return 2;
+    }
+
+    static BenchRun baseline, current;
+    if (LoadRun(paths[0], &baseline) != 0 || LoadRun(paths[1], &current) != 0) return 2;
+
+    int regressions = 0;
+    printf("%-30s %10s %10s %8s %10s  %s\n", "benchmark", "base ns", "current ns", "change", "threshold", "result");
+    for (int i = 0; i < current.count; i++) {
+        const BenchEntry* now = &current.entries[i];
+        const BenchEntry* base = FindEntry(&baseline, now->name);
+        if (!base) {
+            printf("%-30s %10s %10.3f %8s %10s  new\n", now->name, "-", now->median, "-", "-");
+            continue;
+        }
+        double errorBase = MedianError(base->mad, baseline.samples);
+        double errorNow = MedianError(now->mad, current.samples);
+        double threshold = k * sqrt(errorBase * errorBase + errorNow * errorNow);
+        double delta = now->median - base->median;
+        const char* result = "ok";
+        if (delta > threshold) {
+            result = "REGRESSION";
+            regressions++;
+        } else if (-delta > threshold) {
+            result = "faster";
+        }
+        printf("%-30s %10.3f %10.3f %+7.1f%% %10.3f  %s\n", now->name, base->median, now->median,
+               base->median > 0 ? 100.0 * delta / base->median : 0.0, threshold, result);
+    }
+    for (int i = 0; i < baseline.count; i++) {
+        if (!FindEntry(&current, baseline.entries[i].name)) {
+            printf("%-30s %10.3f %10s %8s %10s  missing\n", baseline.entries[i].name, baseline.entries[i].median, "-", "-", "-");
+        }
+    }
+
+    if (regressions > 0) {
+        fflush(stdout);
+        fprintf(stderr, "bench_compare: %d regression%s beyond %.1f sigma\n", regressions, regressions == 1 ? "" : "s", k);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,239 @@
+// Microbenchmarks for the collision primitives in src/geometry.h and the
+// wing transform, e.g.
+//
+//   bench_geom [--json out.json] [filter]
+//
+// Each benchmark is warmed up, then timed over BENCH_SAMPLES samples of
+// enough calls to last about BENCH_SAMPLE_NS; it reports the median ns per
+// call, the median absolute deviation and the throughput. Only benchmarks
+// whose name contains filter are run. --json also writes the results, one
+// benchmark object per line, for bench_compare.
+#define _POSIX_C_SOURCE 200809L
+#define NO_ENGINE_COUNTERS // time the primitives alone
+#define RAYMATH_STATIC_INLINE
+
+#include "geometry.c"
+#include "raymath.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_SAMPLES 101
+#define BENCH_SAMPLE_NS 2000000ull // 2 ms
+#define BENCH_WARMUP_NS 200000000ull // 200 ms
+#define BENCH_INPUTS 4096 // power of two
+#define BENCH_BATCH_SEGMENTS 64 // about a crowded collision query
+#define WING_WIDTH 40 // as in screen_gameplay.c
+
+typedef struct {
+    Vector2 a, b, c, d;
+} BenchInput;
+
+typedef struct {
+    double median;     // ns per call
+    double mad;        // ns per call
+    uint64_t iterations; // per sample
+} BenchResult;
+
+typedef struct {
+    const char* name;
+    void (*run)(const BenchInput* inputs, uint64_t iterations);
+    int callsPerIteration;
+    bool collinear; // adversarial inputs: all four points on one line
+} Benchmark;
+
+static BenchInput randomInputs[BENCH_INPUTS];
+static BenchInput collinearInputs[BENCH_INPUTS];
+static volatile int benchSink; // keeps results observable
+static uint32_t benchSeed = 12345;
+
+static uint64_t BenchNow(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static float BenchRandom(float min, float max) {
+    benchSeed = benchSeed * 1664525u + 1013904223u;
+    return min + (max - min) * (float)(benchSeed >> 8) / (float)(1u << 24);
+}
+
+static Vector2 RandomPoint(void) {
+    return (Vector2){ BenchRandom(-1000, 1000), BenchRandom(-1000, 1000) };
+}
+
+// Points on y = 0.5x + 3 at integer x, so the cross products are exactly 0
+static Vector2 CollinearPoint(void) {
+    float x = (float)(int)BenchRandom(-1000, 1000);
+    return (Vector2){ x, 0.5f * x + 3 };
+}
+
+static void BenchOrientation(const BenchInput* inputs, uint64_t iterations) {
+    int sum = 0;
+    for (uint64_t i = 0; i < iterations; i++) {
+        const BenchInput* in = &inputs[i & (BENCH_INPUTS - 1)];
+        sum += orientation(in->a, in->b, in->c);
+    }
+    benchSink = sum;
+}
+
+static void BenchIntersects(const BenchInput* inputs, uint64_t iterations) {
+    int sum = 0;
+    for (uint64_t i = 0; i < iterations; i++) {
+        const BenchInput* in = &inputs[i & (BENCH_INPUTS - 1)];
+        sum += intersects(in->a, in->b, in->c, in->d);
+    }
+    benchSink = sum;
+}
+
+// The wings are short and near the player, like in a real tick
+static void BenchCollisionWithLine(const BenchInput* inputs, uint64_t iterations) {
+    int sum = 0;
+    for (uint64_t i = 0; i < iterations; i++) {
+        const BenchInput* in = &inputs[i & (BENCH_INPUTS - 1)];
+        Vector2 left = { in->a.x - WING_WIDTH, in->a.y + in->b.y * 0.02f };
+        Vector2 right = { in->a.x + WING_WIDTH, in->a.y - in->b.y * 0.02f };
+        sum += CollisionWithLine(in->a, left, right, in->c, in->d);
+    }
+    benchSink = sum;
+}
+
+// One player against BENCH_BATCH_SEGMENTS consecutive segments, as the
+// collision loop in ScreenGameplay_Update runs over a query result
+static void BenchCollisionBatch(const BenchInput* inputs, uint64_t iterations) {
+    int sum = 0;
+    for (uint64_t i = 0; i < iterations; i++) {
+        const BenchInput* player = &inputs[i & (BENCH_INPUTS - 1)];
+        Vector2 left = { player->a.x - WING_WIDTH, player->a.y };
+        Vector2 right = { player->a.x + WING_WIDTH, player->a.y };
+        uint64_t first = (i * BENCH_BATCH_SEGMENTS) & (BENCH_INPUTS - 1);
+        for (int s = 0; s < BENCH_BATCH_SEGMENTS; s++) {
+            const BenchInput* segment = &inputs[(first + s) & (BENCH_INPUTS - 1)];
+            sum += CollisionWithLine(player->a, left, right, segment->c, segment->d);
+        }
+    }
+    benchSink = sum;
+}
+
+// Same chain as GetWingPositions: rotate both wings by the player rotation,
+// then by the flap, then translate
+static void BenchWingTransform(const BenchInput* inputs, uint64_t iterations) {
+    float sum = 0;
+    for (uint64_t i = 0; i < iterations; i++) {
+        const BenchInput* in = &inputs[i & (BENCH_INPUTS - 1)];
+        float rot = in->b.x;
+        float flap = in->b.y * 0.05f;
+        Vector2 left = Vector2Rotate((Vector2){-WING_WIDTH, 0}, rot * DEG2RAD);
+        Vector2 right = Vector2Rotate((Vector2){WING_WIDTH, 0}, rot * DEG2RAD);
+        left = Vector2Add(Vector2Rotate(left, -flap * DEG2RAD), in->a);
+        right = Vector2Add(Vector2Rotate(right, flap * DEG2RAD), in->a);
+        sum += left.x + right.y;
+    }
+    benchSink = (int)sum;
+}
+
+static const Benchmark benchmarks[] = {
+    { "orientation/random", BenchOrientation, 1, false },
+    { "orientation/collinear", BenchOrientation, 1, true },
+    { "intersects/random", BenchIntersects, 1, false },
+    { "intersects/collinear", BenchIntersects, 1, true },
+    { "CollisionWithLine/random", BenchCollisionWithLine, 1, false },
+    { "CollisionWithLine/collinear", BenchCollisionWithLine, 1, true },
+    { "CollisionWithLine/batch64", BenchCollisionBatch, BENCH_BATCH_SEGMENTS, false },
+    { "WingTransform/random", BenchWingTransform, 1, false },
+};
+
+static int CompareDoubles(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static double Median(double* values, int count) {
+    qsort(values, count, sizeof(double), CompareDoubles);
+    return count % 2 ? values[count / 2] : (values[count / 2 - 1] + values[count / 2]) / 2;
+}
+
+static BenchResult RunBenchmark(const Benchmark* bench) {
+    const BenchInput* inputs = bench->collinear ? collinearInputs : randomInputs;
+
+    // Warm up while finding how many iterations fill one sample
+    uint64_t iterations = 1;
+    uint64_t warmupStart = BenchNow();
+    for (;;) {
+        uint64_t start = BenchNow();
+        bench->run(inputs, iterations);
+        uint64_t elapsed = BenchNow() - start;
+        if (elapsed < BENCH_SAMPLE_NS) {
+            iterations *= 2;
+        } else if (BenchNow() - warmupStart >= BENCH_WARMUP_NS) {
+            break;
+        }
+    }
+
+    double samples[BENCH_SAMPLES];
+    for (int i = 0; i < BENCH_SAMPLES; i++) {
+        uint64_t start = BenchNow();
+        bench->run(inputs, iterations);
+        uint64_t elapsed = BenchNow() - start;
+        samples[i] = (double)elapsed / ((double)iterations * bench->callsPerIteration);
+    }
+    double median = Median(samples, BENCH_SAMPLES);
+    for (int i = 0; i < BENCH_SAMPLES; i++) {
+        samples[i] = samples[i] > median ? samples[i] - median : median - samples[i];
+    }
+    double mad = Median(samples, BENCH_SAMPLES);
+
+    printf("%-30s %10.3f %9.3f %7.2f%% %10.2f\n", bench->name, median, mad,
+           median > 0 ? 100.0 * mad / median : 0.0, median > 0 ? 1e3 / median : 0.0);
+    fflush(stdout);
+    return (BenchResult){ median, mad, iterations };
+}
+
+static int WriteJson(const char* filename, const BenchResult* results, const bool* ran) {
+    FILE* file = fopen(filename, "w");
+    if (!file) {
+        perror(filename);
+        return -1;
+    }
+    fprintf(file, "{\"samples\": %d, \"benchmarks\": [\n", BENCH_SAMPLES);
+    bool first = true;
+    for (size_t i = 0; i < sizeof(benchmarks) / sizeof(benchmarks[0]); i++) {
+        if (!ran[i]) continue;
+        fprintf(file, "%s{\"name\": \"%s\", \"median_ns\": %.6f, \"mad_ns\": %.6f, \"iterations\": %llu}",
+                first ? "" : ",\n", benchmarks[i].name, results[i].median, results[i].mad,
+                (unsigned long long)results[i].iterations);
+        first = false;
+    }
+    fprintf(file, "\n]}\n");
+    return fclose(file) == 0 ? 0 : -1;
+}
+
+int main(int argc, char** argv) {
+    const char* filter = "";
+    const char* jsonPath = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else {
+            filter = argv[i];
+        }
+    }
+    for (int i = 0; i < BENCH_INPUTS; i++) {
+        randomInputs[i] = (BenchInput){ RandomPoint(), RandomPoint(), RandomPoint(), RandomPoint() };
+        collinearInputs[i] = (BenchInput){ CollinearPoint(), CollinearPoint(), CollinearPoint(), CollinearPoint() };
+    }
+
+    printf("%-30s %10s %9s %8s %10s\n", "benchmark", "ns/call", "MAD", "MAD%", "Mcalls/s");
+    BenchResult results[sizeof(benchmarks) / sizeof(benchmarks[0])];
+    bool ran[sizeof(benchmarks) / sizeof(benchmarks[0])] = {0};
+    for (size_t i = 0; i < sizeof(benchmarks) / sizeof(benchmarks[0]); i++) {
+        if (!strstr(benchmarks[i].name, filter)) continue;
+        results[i] = RunBenchmark(&benchmarks[i]);
+        ran[i] = true;
+    }
+    if (jsonPath && WriteJson(jsonPath, results, ran) != 0) return 1;
+    return 0;
+}
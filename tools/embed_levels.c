@@ -0,0 +1,68 @@
+// Converts level files into a C header of Level initializers so they can be
+// linked into the game (build with -DEMBED_LEVELS).
+//
+//   embed_levels src/levels_embedded.h level0 level1 ...
+#define _POSIX_C_SOURCE 200809L
+
+#include "level.c"
+#include "segment_pack.c"
+#include <stdio.h>
+
+static void WriteVector(FILE* out, Vector2 v) {
+    // Hex floats round-trip exactly
+    fprintf(out, "{%af, %af}", v.x, v.y);
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <output.h> <level>...\n", argv[0]);
+        return 1;
+    }
+    FILE* out = fopen(argv[1], "w");
+    if (!out) {
+        fprintf(stderr, "embed_levels: cannot write %s\n", argv[1]);
+        return 1;
+    }
+
+    fprintf(out, "// Generated by tools/embed_levels.c, do not edit\n");
+    fprintf(out, "#ifndef LEVELS_EMBEDDED_H\n#define LEVELS_EMBEDDED_H\n\n");
+    fprintf(out, "#define EMBEDDED_LEVEL_COUNT %d\n\n", argc - 2);
+
+    fprintf(out, "static const char* embeddedLevelNames[EMBEDDED_LEVEL_COUNT] = {\n");
+    for (int i = 2; i < argc; i++) {
+        fprintf(out, "    \"%s\",\n", argv[i]);
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "static const Level embeddedLevels[EMBEDDED_LEVEL_COUNT] = {\n");
+    for (int i = 2; i < argc; i++) {
+        Level level;
+        FILE* file = fopen(argv[i], "rb");
+        if (!file) {
+            fprintf(stderr, "embed_levels: cannot read %s\n", argv[i]);
+            fclose(out);
+            remove(argv[1]);
+            return 1;
+        }
+        fclose(file);
+        load_level(&level, argv[i]);
+
+        fprintf(out, "    { // %s\n        .segments = {\n", argv[i]);
+        if (level.segmentCount == 0) {
+            fprintf(out, "            {{0}},\n");
+        }
+        for (int s = 0; s < level.segmentCount; s++) {
+            fprintf(out, "            {");
+            WriteVector(out, level.segments[s].start);
+            fprintf(out, ", ");
+            WriteVector(out, level.segments[s].end);
+            fprintf(out, "},\n");
+        }
+        fprintf(out, "        },\n        .segmentCount = %d,\n        .goal = ", level.segmentCount);
+        WriteVector(out, level.goal);
+        fprintf(out, ",\n    },\n");
+    }
+    fprintf(out, "};\n\n#endif\n");
+    fclose(out);
+    return 0;
+}
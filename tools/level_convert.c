@@ -0,0 +1,130 @@
+// Converts between level files and the text format in src/level_text.h.
+//
+//   level_convert export <level> [<out.txt>]
+//   level_convert import <in.txt> <level>
+//   level_convert import-world <in.txt> <out.world>
+//
+// Importing snaps segment endpoints to the packed 1/4-unit grid, so text ->
+// binary -> text is only exact for text already on that grid.
+#define _POSIX_C_SOURCE 200809L
+#define NO_PROFILER // the world loader thread is not used here
+
+#include "memory_tracker.c"
+#include "level.c"
+#include "segment_pack.c"
+#include "level_text.c"
+#include "world.c"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    LineSegment* segments;
+    int count;
+    int capacity;
+    Vector2 goal;
+} SegmentList;
+
+static int AddWorldSegment(void* user, LineSegment segment, const char** message) {
+    SegmentList* list = user;
+    if (list->count == list->capacity) {
+        int capacity = list->capacity ? list->capacity * 2 : 4096;
+        LineSegment* segments = realloc(list->segments, capacity * sizeof(LineSegment));
+        if (!segments) {
+            *message = "out of memory";
+            return -1;
+        }
+        list->segments = segments;
+        list->capacity = capacity;
+    }
+    list->segments[list->count++] = segment;
+    return 0;
+}
+
+static int SetWorldGoal(void* user, Vector2 goal, const char** message) {
+    (void)message;
+    ((SegmentList*)user)->goal = goal;
+    return 0;
+}
+
+static FILE* OpenInput(const char* filename) {
+    FILE* in = strcmp(filename, "-") == 0 ? stdin : fopen(filename, "rb");
+    if (!in) fprintf(stderr, "level_convert: cannot read %s\n", filename);
+    return in;
+}
+
+static int Export(const char* levelFile, const char* textFile) {
+    FILE* check = fopen(levelFile, "rb");
+    if (!check) {
+        fprintf(stderr, "level_convert: cannot read %s\n", levelFile);
+        return 1;
+    }
+    fclose(check);
+
+    Level level;
+    load_level(&level, levelFile);
+    FILE* out = textFile ? fopen(textFile, "w") : stdout;
+    if (!out) {
+        fprintf(stderr, "level_convert: cannot write %s\n", textFile);
+        return 1;
+    }
+    fprintf(out, "# %s\n", levelFile);
+    int result = LevelText_WriteLevel(out, &level);
+    if (out != stdout) fclose(out);
+    return result == 0 ? 0 : 1;
+}
+
+static int Import(const char* textFile, const char* levelFile) {
+    FILE* in = OpenInput(textFile);
+    if (!in) return 1;
+    Level level;
+    LevelTextError error;
+    int result = LevelText_ReadLevel(in, &level, &error);
+    if (in != stdin) fclose(in);
+    if (result != 0) {
+        fprintf(stderr, "%s:%d: %s\n", textFile, error.line, error.message);
+        return 1;
+    }
+    if (save_level(&level, levelFile) != 0) {
+        fprintf(stderr, "level_convert: cannot write %s\n", levelFile);
+        return 1;
+    }
+    return 0;
+}
+
+static int ImportWorld(const char* textFile, const char* worldFile) {
+    FILE* in = OpenInput(textFile);
+    if (!in) return 1;
+    SegmentList list = {0};
+    LevelTextSink sink = { AddWorldSegment, SetWorldGoal, &list };
+    LevelTextError error;
+    int result = LevelText_Parse(in, &sink, &error);
+    if (in != stdin) fclose(in);
+    if (result != 0) {
+        fprintf(stderr, "%s:%d: %s\n", textFile, error.line, error.message);
+    } else if (World_Write(worldFile, list.segments, list.count, list.goal) != 0) {
+        fprintf(stderr, "level_convert: cannot write %s\n", worldFile);
+        result = -1;
+    }
+    free(list.segments);
+    return result == 0 ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 3 && strcmp(argv[1], "export") == 0) {
+        return Export(argv[2], argc >= 4 ? argv[3] : NULL);
+    }
+    if (argc == 4 && strcmp(argv[1], "import") == 0) {
+        return Import(argv[2], argv[3]);
+    }
+    if (argc == 4 && strcmp(argv[1], "import-world") == 0) {
+        return ImportWorld(argv[2], argv[3]);
+    }
+    fprintf(stderr,
+            "usage: %s export <level> [<out.txt>]\n"
+            "       %s import <in.txt> <level>\n"
+            "       %s import-world <in.txt> <out.world>\n"
+            "importing snaps segment endpoints to a 1/4-unit grid\n",
+            argv[0], argv[0], argv[0]);
+    return 1;
+}
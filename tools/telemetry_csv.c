@@ -0,0 +1,81 @@
+// Converts a telemetry log written with --telemetry-log to CSV, oldest
+// record first, e.g.
+//
+//   telemetry_csv flywrench.tlog [out.csv]
+//
+// Unwritten and torn records are skipped.
+#define _POSIX_C_SOURCE 200809L
+
+#include "telemetry.c"
+#include "engine_counters.c"
+#include "telemetry_log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+
+static int CompareSequence(const void* a, const void* b) {
+    uint64_t x = ((const TelemetryLogRecord*)a)->sequence;
+    uint64_t y = ((const TelemetryLogRecord*)b)->sequence;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        fprintf(stderr, "usage: %s <log> [<out.csv>]\n", argv[0]);
+        return 1;
+    }
+    FILE* in = fopen(argv[1], "rb");
+    if (!in) {
+        perror(argv[1]);
+        return 1;
+    }
+    // The file must hold exactly the records its header claims, as
+    // TelemetryLog_Open requires, before that count sizes an allocation
+    struct stat info;
+    TelemetryLogHeader header;
+    if (fstat(fileno(in), &info) != 0 || fread(&header, sizeof(header), 1, in) != 1 || header.magic != TELEMETRY_LOG_MAGIC ||
+        header.version != TELEMETRY_LOG_VERSION || header.recordSize != sizeof(TelemetryLogRecord) ||
+        (unsigned long long)info.st_size != sizeof(header) + (unsigned long long)header.recordCount * sizeof(TelemetryLogRecord)) {
+        fprintf(stderr, "telemetry_csv: %s is not a version %d telemetry log\n", argv[1], TELEMETRY_LOG_VERSION);
+        fclose(in);
+        return 1;
+    }
+    TelemetryLogRecord* records = malloc((size_t)header.recordCount * sizeof(TelemetryLogRecord));
+    if (!records) {
+        fclose(in);
+        return 1;
+    }
+    size_t read = fread(records, sizeof(TelemetryLogRecord), header.recordCount, in);
+    fclose(in);
+
+    size_t count = 0;
+    for (size_t i = 0; i < read; i++) {
+        if (records[i].sequence != 0) records[count++] = records[i];
+    }
+    qsort(records, count, sizeof(TelemetryLogRecord), CompareSequence);
+
+    FILE* out = argc == 3 ? fopen(argv[2], "w") : stdout;
+    if (!out) {
+        perror(argv[2]);
+        free(records);
+        return 1;
+    }
+    fprintf(out, "sequence,wall_time_ms,frame_ms,screen,idle");
+    for (int c = 0; c < ENGINE_COUNTER_COUNT && c < TELEMETRY_LOG_COUNTERS; c++) {
+        fprintf(out, ",%s", EngineCounters_Name(c));
+    }
+    fprintf(out, "\n");
+    for (size_t i = 0; i < count; i++) {
+        const TelemetryLogRecord* r = &records[i];
+        fprintf(out, "%llu,%lld,%.3f,%d,%d", (unsigned long long)r->sequence, (long long)r->wallTimeMs,
+                r->frameMs, (int)r->screen, (r->flags & TELEMETRY_LOG_IDLE) ? 1 : 0);
+        for (int c = 0; c < ENGINE_COUNTER_COUNT && c < TELEMETRY_LOG_COUNTERS; c++) {
+            fprintf(out, ",%u", r->counters[c]);
+        }
+        fprintf(out, "\n");
+    }
+    free(records);
+    if (out != stdout && fclose(out) != 0) return 1;
+    fprintf(stderr, "telemetry_csv: %zu records\n", count);
+    return 0;
+}
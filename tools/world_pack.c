@@ -0,0 +1,64 @@
+// Lays level files out side by side into one streamed world, e.g.
+//
+//   world_pack level7.world level0 level1 level2 level3 level4 level5 level6
+//
+// The player spawns in the first level; the goal is the last level's goal.
+#define _POSIX_C_SOURCE 200809L
+#define NO_PROFILER // the world loader thread is not used here
+
+#include "memory_tracker.c"
+#include "level.c"
+#include "segment_pack.c"
+#include "world.c"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define WORLD_PACK_GAP 512.0f
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <output.world> <level>...\n", argv[0]);
+        return 1;
+    }
+    int levelCount = argc - 2;
+    LineSegment* segments = malloc((size_t)levelCount * MAX_SEGMENTS * sizeof(LineSegment));
+    if (!segments) return 1;
+
+    int segmentCount = 0;
+    float offsetX = 0.0f;
+    Vector2 goal = {0};
+    for (int i = 0; i < levelCount; i++) {
+        Level level;
+        load_level(&level, argv[i + 2]);
+        if (level.segmentCount == 0) {
+            fprintf(stderr, "world_pack: %s has no segments, skipped\n", argv[i + 2]);
+            continue;
+        }
+
+        float minX = level.segments[0].start.x;
+        float maxX = minX;
+        for (int s = 0; s < level.segmentCount; s++) {
+            minX = fminf(minX, fminf(level.segments[s].start.x, level.segments[s].end.x));
+            maxX = fmaxf(maxX, fmaxf(level.segments[s].start.x, level.segments[s].end.x));
+        }
+        // The first level stays in place so the spawn point is unchanged
+        float shift = (segmentCount == 0) ? 0.0f : offsetX - minX;
+        for (int s = 0; s < level.segmentCount; s++) {
+            LineSegment segment = level.segments[s];
+            segment.start.x += shift;
+            segment.end.x += shift;
+            segments[segmentCount++] = segment;
+        }
+        goal = (Vector2){ level.goal.x + shift, level.goal.y };
+        offsetX = maxX + shift + WORLD_PACK_GAP;
+    }
+
+    if (World_Write(argv[1], segments, segmentCount, goal) != 0) {
+        fprintf(stderr, "world_pack: cannot write %s\n", argv[1]);
+        free(segments);
+        return 1;
+    }
+    printf("%s: %d segments\n", argv[1], segmentCount);
+    free(segments);
+    return 0;
+}